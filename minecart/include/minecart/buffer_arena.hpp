@@ -0,0 +1,162 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <vector>
+#include <map>
+#include <string>
+#include <stdexcept>
+#include <cstdint>
+
+#include "minecart/upload_queue.hpp"
+
+namespace minecart::graphics {
+
+    // Exception class for arena-related errors
+    class ArenaException : public std::runtime_error {
+    public:
+        explicit ArenaException(const std::string& message)
+            : std::runtime_error("Arena error: " + message) {}
+    };
+
+    // A placed region inside one of the arena's buffers
+    struct ArenaRegion {
+        SDL_GPUBuffer* buffer = nullptr;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    // Counters describing arena occupancy
+    struct GpuBufferArenaStats {
+        uint32_t pages = 0;                 // Driver buffers owned by the arena
+        uint32_t allocations = 0;           // Live allocations
+        uint64_t capacityBytes = 0;         // Total size of all pages
+        uint64_t usedBytes = 0;             // Bytes covered by live allocations
+        uint64_t largestFreeBlock = 0;      // Largest contiguous free range in any page
+        uint64_t defragmentations = 0;      // Completed defragment() calls
+        uint64_t bytesMoved = 0;            // Bytes copied by defragmentation
+    };
+
+    // Places many small meshes inside a few large GPU buffers. Each page is one
+    // SDL_GPUBuffer managed by a best-fit free list that coalesces on free, so
+    // meshes in the same page share vertex and index bindings and are drawn with
+    // base-vertex / first-index offsets.
+    //
+    // Allocations are referred to by handle so defragment() can move them.
+    class GpuBufferArena {
+    public:
+        using Handle = uint32_t;
+        static constexpr Handle INVALID_HANDLE = 0;
+        static constexpr uint32_t DEFAULT_PAGE_SIZE = 64 * 1024 * 1024;
+
+        // Constructor - takes non-owning pointers to device and (optionally) the upload
+        // queue, whose pending copies are flushed before defragmentation moves data.
+        GpuBufferArena(SDL_GPUDevice* device,
+                       SDL_GPUBufferUsageFlags usage = SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_INDEX,
+                       uint32_t pageSize = DEFAULT_PAGE_SIZE,
+                       UploadQueue* uploadQueue = nullptr);
+        ~GpuBufferArena();
+
+        // Prevent copying and moving (models keep a pointer to their arena)
+        GpuBufferArena(const GpuBufferArena&) = delete;
+        GpuBufferArena& operator=(const GpuBufferArena&) = delete;
+        GpuBufferArena(GpuBufferArena&&) = delete;
+        GpuBufferArena& operator=(GpuBufferArena&&) = delete;
+
+        // Allocate size bytes whose offset is a multiple of alignment (any non-zero value,
+        // e.g. the vertex stride so offset / stride is a valid base vertex)
+        [[nodiscard]] Handle allocate(uint32_t size, uint32_t alignment);
+        void free(Handle handle) noexcept;
+
+        // Resolve a handle to its current buffer and offset (changes after defragment())
+        [[nodiscard]] ArenaRegion get_region(Handle handle) const;
+
+        // Pack live allocations to the front of each page using GPU copies and drop empty pages
+        void defragment();
+
+        // Accessors
+        [[nodiscard]] SDL_GPUDevice* get_device() const noexcept { return m_device; }
+        [[nodiscard]] UploadQueue* get_upload_queue() const noexcept { return m_uploadQueue; }
+        [[nodiscard]] GpuBufferArenaStats get_stats() const noexcept;
+
+    private:
+        struct Page {
+            SDL_GPUBuffer* buffer = nullptr;
+            uint32_t size = 0;
+            std::map<uint32_t, uint32_t> freeByOffset;          // offset -> size
+            std::multimap<uint32_t, uint32_t> freeBySize;       // size -> offset
+        };
+
+        struct Slot {
+            uint32_t page = 0;
+            uint32_t offset = 0;        // Aligned start handed to the caller
+            uint32_t blockOffset = 0;   // Start of the reserved block (includes alignment padding)
+            uint32_t blockSize = 0;
+            uint32_t size = 0;
+            uint32_t alignment = 1;
+            bool live = false;
+        };
+
+        uint32_t create_page(uint32_t size);
+        void release_page(Page& page) noexcept;
+        bool try_allocate_in_page(uint32_t pageIndex, uint32_t size, uint32_t alignment, Slot& slot);
+        void insert_free(Page& page, uint32_t offset, uint32_t size);
+        void erase_free(Page& page, uint32_t offset, uint32_t size);
+
+        SDL_GPUDevice* m_device;        // Non-owning
+        UploadQueue* m_uploadQueue;     // Non-owning, may be null
+        SDL_GPUBufferUsageFlags m_usage;
+        uint32_t m_pageSize;
+
+        std::vector<Page> m_pages;
+        std::vector<Slot> m_slots;          // Indexed by handle - 1
+        std::vector<Handle> m_freeSlots;
+
+        uint64_t m_defragmentations = 0;
+        uint64_t m_bytesMoved = 0;
+    };
+
+    // Owning reference to an arena allocation; frees it on destruction
+    class ArenaAllocation {
+    public:
+        ArenaAllocation() = default;
+        ArenaAllocation(GpuBufferArena* arena, GpuBufferArena::Handle handle) noexcept
+            : m_arena(arena), m_handle(handle) {}
+        ~ArenaAllocation() { reset(); }
+
+        // Prevent copying
+        ArenaAllocation(const ArenaAllocation&) = delete;
+        ArenaAllocation& operator=(const ArenaAllocation&) = delete;
+
+        // Allow moving
+        ArenaAllocation(ArenaAllocation&& other) noexcept
+            : m_arena(other.m_arena), m_handle(other.m_handle) {
+            other.m_handle = GpuBufferArena::INVALID_HANDLE;
+        }
+        ArenaAllocation& operator=(ArenaAllocation&& other) noexcept {
+            if (this != &other) {
+                reset();
+                m_arena = other.m_arena;
+                m_handle = other.m_handle;
+                other.m_handle = GpuBufferArena::INVALID_HANDLE;
+            }
+            return *this;
+        }
+
+        void reset() noexcept {
+            if (m_arena && m_handle != GpuBufferArena::INVALID_HANDLE) {
+                m_arena->free(m_handle);
+            }
+            m_handle = GpuBufferArena::INVALID_HANDLE;
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept { return m_handle != GpuBufferArena::INVALID_HANDLE; }
+        [[nodiscard]] GpuBufferArena::Handle get_handle() const noexcept { return m_handle; }
+        [[nodiscard]] ArenaRegion get_region() const { return m_arena->get_region(m_handle); }
+
+    private:
+        GpuBufferArena* m_arena = nullptr;  // Non-owning
+        GpuBufferArena::Handle m_handle = GpuBufferArena::INVALID_HANDLE;
+    };
+
+} // namespace minecart::graphics
@@ -4,13 +4,28 @@
 
 #include <array>
 #include <cmath>
+#include <cstdint>
 
 #include "glm/glm.hpp"
 #include "glm/gtc/matrix_transform.hpp"
 #include "glm/gtc/type_ptr.hpp"
 
+#include "minecart/culling.hpp"
+
 namespace minecart::graphics {
 
+    // How the projection matrix maps view depth
+    enum class ProjectionMode {
+        Standard,           // glm::perspective with near and far planes
+        ReverseZInfinite    // Depth 1 at the near plane, 0 at infinity (clear depth to 0, compare GREATER)
+    };
+
+    // Matrices and direction vectors are evaluated lazily: setters only mark
+    // state dirty, and the first getter afterwards recomputes what it needs.
+    //
+    // Because of that the const getters write the caches and are not safe to call
+    // from several threads at once, unless update() has run since the last change.
+    // Call update() before handing the camera to concurrent readers (e.g. culling jobs).
     class Camera {
     public:
         Camera();
@@ -39,7 +54,9 @@ namespace minecart::graphics {
 
         // Projection settings
         void set_perspective(float fovY, float aspect, float nearZ, float farZ);
+        void set_reverse_z_infinite(float fovY, float aspect, float nearZ);
         void set_aspect_ratio(float aspect);
+        [[nodiscard]] ProjectionMode get_projection_mode() const noexcept { return m_projectionMode; }
 
         // Movement helpers
         void move_forward(float distance);
@@ -49,46 +66,79 @@ namespace minecart::graphics {
         // Mouse look (delta in pixels, sensitivity is multiplier)
         void rotate(float deltaPitch, float deltaYaw);
 
-        // Update matrices (call after changing position/rotation)
+        // Recompute everything now. Afterwards the getters only read until the camera changes.
         void update();
 
-        // Get matrices
-        [[nodiscard]] const glm::mat4& get_view_matrix() const noexcept { return m_viewMatrix; }
-        [[nodiscard]] const glm::mat4& get_projection_matrix() const noexcept { return m_projectionMatrix; }
-        [[nodiscard]] glm::mat4 get_view_projection() const { return m_projectionMatrix * m_viewMatrix; }
+        // Get matrices (cached until the camera changes)
+        [[nodiscard]] const glm::mat4& get_view_matrix() const;
+        [[nodiscard]] const glm::mat4& get_projection_matrix() const;
+        [[nodiscard]] const glm::mat4& get_view_projection() const;
+        [[nodiscard]] const glm::mat4& get_inverse_view() const;
+        [[nodiscard]] const glm::mat4& get_inverse_projection() const;
+        [[nodiscard]] const glm::mat4& get_inverse_view_projection() const;
 
         // Get the MVP matrix for a given model matrix
         [[nodiscard]] glm::mat4 get_mvp(const glm::mat4& modelMatrix) const {
-            return m_projectionMatrix * m_viewMatrix * modelMatrix;
+            return get_view_projection() * modelMatrix;
         }
 
+        // World-space frustum planes of the current view and projection
+        [[nodiscard]] const Frustum& get_frustum() const;
+
         // Direction vectors
-        [[nodiscard]] glm::vec3 get_forward() const noexcept { return m_forward; }
-        [[nodiscard]] glm::vec3 get_right() const noexcept { return m_right; }
-        [[nodiscard]] glm::vec3 get_up() const noexcept { return m_up; }
+        [[nodiscard]] glm::vec3 get_forward() const { update_vectors(); return m_forward; }
+        [[nodiscard]] glm::vec3 get_right() const { update_vectors(); return m_right; }
+        [[nodiscard]] glm::vec3 get_up() const { update_vectors(); return m_up; }
 
     private:
-        void update_vectors();
+        enum DirtyFlags : uint32_t {
+            DIRTY_VECTORS = 1u << 0,
+            DIRTY_VIEW = 1u << 1,
+            DIRTY_PROJECTION = 1u << 2,
+            DIRTY_VIEW_PROJECTION = 1u << 3,
+            DIRTY_INVERSE_VIEW = 1u << 4,
+            DIRTY_INVERSE_PROJECTION = 1u << 5,
+            DIRTY_INVERSE_VIEW_PROJECTION = 1u << 6,
+            DIRTY_FRUSTUM = 1u << 7,
+
+            // Everything derived from position/orientation, or from projection settings
+            DIRTY_ORIENTATION = DIRTY_VECTORS | DIRTY_VIEW | DIRTY_VIEW_PROJECTION | DIRTY_INVERSE_VIEW
+                              | DIRTY_INVERSE_VIEW_PROJECTION | DIRTY_FRUSTUM,
+            DIRTY_POSITION = DIRTY_ORIENTATION & ~DIRTY_VECTORS,
+            DIRTY_PROJECTION_ALL = DIRTY_PROJECTION | DIRTY_VIEW_PROJECTION | DIRTY_INVERSE_PROJECTION
+                                 | DIRTY_INVERSE_VIEW_PROJECTION | DIRTY_FRUSTUM,
+            DIRTY_ALL = DIRTY_ORIENTATION | DIRTY_PROJECTION_ALL
+        };
+
+        void update_vectors() const;
+        [[nodiscard]] bool clean(uint32_t flag) const noexcept;
 
         glm::vec3 m_position{0.0f, 0.0f, 3.0f};
         float m_pitch{0.0f};  // Up/down rotation
         float m_yaw{-1.5708f};   // Left/right rotation (start looking at -Z)
 
-        glm::vec3 m_forward{0.0f, 0.0f, -1.0f};
-        glm::vec3 m_right{1.0f, 0.0f, 0.0f};
-        glm::vec3 m_up{0.0f, 1.0f, 0.0f};
+        mutable glm::vec3 m_forward{0.0f, 0.0f, -1.0f};
+        mutable glm::vec3 m_right{1.0f, 0.0f, 0.0f};
+        mutable glm::vec3 m_up{0.0f, 1.0f, 0.0f};
 
         static constexpr glm::vec3 WORLD_UP{0.0f, 1.0f, 0.0f};
 
         // Projection parameters
+        ProjectionMode m_projectionMode{ProjectionMode::Standard};
         float m_fovY{1.0472f};     // 60 degrees in radians
         float m_aspect{16.0f / 9.0f};
         float m_nearZ{0.1f};
         float m_farZ{1000.0f};
 
-        // Cached matrices
-        glm::mat4 m_viewMatrix;
-        glm::mat4 m_projectionMatrix;
+        // Cached values, valid while their dirty flag is clear
+        mutable uint32_t m_dirty{DIRTY_ALL};
+        mutable glm::mat4 m_viewMatrix;
+        mutable glm::mat4 m_projectionMatrix;
+        mutable glm::mat4 m_viewProjection;
+        mutable glm::mat4 m_inverseView;
+        mutable glm::mat4 m_inverseProjection;
+        mutable glm::mat4 m_inverseViewProjection;
+        mutable Frustum m_frustum;
     };
 
 } // namespace minecart::graphics
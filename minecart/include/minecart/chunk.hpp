@@ -0,0 +1,252 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace minecart::world {
+
+    // Exception class for chunk storage errors
+    class ChunkException : public std::runtime_error {
+    public:
+        explicit ChunkException(const std::string& message)
+            : std::runtime_error("Chunk error: " + message) {}
+    };
+
+    // Block type stored in a chunk; the meaning of each id is up to the game
+    using BlockId = uint16_t;
+    constexpr BlockId AIR = 0;
+
+    constexpr int SECTION_SIZE = 16;
+    constexpr int SECTION_VOLUME = SECTION_SIZE * SECTION_SIZE * SECTION_SIZE;
+
+    // Index of a block within a section. x varies fastest, then z, then y, which is
+    // the order for_each() and get_all() visit blocks in.
+    [[nodiscard]] constexpr uint32_t section_index(int x, int y, int z) noexcept {
+        return static_cast<uint32_t>((y << 8) | (z << 4) | x);
+    }
+
+    // A 16x16x16 cube of blocks stored as indices into a palette of the distinct
+    // blocks it contains. Indices are bit-packed into 64-bit words using 1, 2, 4 or
+    // 8 bits (entries never straddle words), widening as the palette grows. A
+    // section holding a single block type stores no indices at all, and one with
+    // more than 256 types stores block ids directly at 16 bits.
+    //
+    // Palette entries are not reference counted; compact() drops unused ones and
+    // narrows the indices again. set() compacts on its own before widening.
+    class ChunkSection {
+    public:
+        explicit ChunkSection(BlockId fill = AIR);
+        ~ChunkSection() = default;
+
+        // Allow copying and moving
+        ChunkSection(const ChunkSection&) = default;
+        ChunkSection& operator=(const ChunkSection&) = default;
+        ChunkSection(ChunkSection&&) noexcept = default;
+        ChunkSection& operator=(ChunkSection&&) noexcept = default;
+
+        // Coordinates are local (0-15)
+        [[nodiscard]] BlockId get(int x, int y, int z) const noexcept { return get_at(section_index(x, y, z)); }
+        [[nodiscard]] BlockId get_at(uint32_t index) const noexcept;
+
+        // Set a block and return the one it replaced
+        BlockId set(int x, int y, int z, BlockId block) { return set_at(section_index(x, y, z), block); }
+        BlockId set_at(uint32_t index, BlockId block);
+
+        // Replace every block; leaves a single-value section
+        void fill(BlockId block);
+
+        // Fill the box [min, max) of local coordinates
+        void fill(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockId block);
+
+        // Decode every block in index order into out
+        void get_all(std::span<BlockId, SECTION_VOLUME> out) const noexcept;
+
+        // Replace every block from data in index order
+        void set_all(std::span<const BlockId, SECTION_VOLUME> data);
+
+        // Call function(index, block) for every block in index order
+        template<typename Function>
+        void for_each(Function&& function) const;
+
+        // Drop unused palette entries and use the narrowest index width
+        void compact();
+
+        // Accessors
+        [[nodiscard]] bool is_empty() const noexcept { return m_nonAirCount == 0; }
+        [[nodiscard]] bool is_uniform() const noexcept { return m_bits == 0; }
+        [[nodiscard]] uint32_t get_non_air_count() const noexcept { return m_nonAirCount; }
+        [[nodiscard]] uint32_t get_bits_per_block() const noexcept { return m_bits; }
+        [[nodiscard]] size_t get_palette_size() const noexcept { return m_palette.size(); }
+        [[nodiscard]] size_t get_memory_usage() const noexcept;
+
+    private:
+        static constexpr uint32_t DIRECT_BITS = 16;
+
+        [[nodiscard]] uint32_t read(uint32_t index) const noexcept;
+        void write(uint32_t index, uint32_t value) noexcept;
+
+        // Palette index for block, adding it (and widening storage) if needed
+        uint32_t palette_index(BlockId block);
+
+        // Re-encode every block with the given bits per entry (0 = single value)
+        void repack(uint32_t bits, const std::vector<BlockId>& palette, std::span<const BlockId, SECTION_VOLUME> blocks);
+
+        std::vector<BlockId> m_palette;     // Empty in direct mode
+        std::vector<uint64_t> m_data;       // Empty for single-value sections
+        uint32_t m_bits = 0;
+        uint32_t m_nonAirCount = 0;
+    };
+
+    template<typename Function>
+    void ChunkSection::for_each(Function&& function) const {
+        if (m_bits == 0) {
+            BlockId block = m_palette[0];
+            for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+                function(i, block);
+            }
+            return;
+        }
+
+        // Walk the words once instead of locating each entry separately
+        const uint32_t perWord = 64 / m_bits;
+        const uint64_t mask = (uint64_t{1} << m_bits) - 1;
+        const bool direct = m_bits == DIRECT_BITS;
+        uint32_t index = 0;
+        for (uint64_t word : m_data) {
+            for (uint32_t j = 0; j < perWord; ++j, word >>= m_bits) {
+                uint32_t value = static_cast<uint32_t>(word & mask);
+                function(index++, direct ? static_cast<BlockId>(value) : m_palette[value]);
+            }
+        }
+    }
+
+    // Horizontal position of a chunk column, in chunks
+    struct ChunkPos {
+        int32_t x = 0;
+        int32_t z = 0;
+
+        bool operator==(const ChunkPos&) const = default;
+    };
+
+    struct ChunkPosHash {
+        size_t operator()(const ChunkPos& pos) const noexcept {
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(pos.x)) << 32) | static_cast<uint32_t>(pos.z);
+            key ^= key >> 33;
+            key *= 0xff51afd7ed558ccdull;
+            key ^= key >> 33;
+            return static_cast<size_t>(key);
+        }
+    };
+
+    // A vertical column of sections. All-air sections are not allocated, so an
+    // empty column costs only its section table. Sections changed since the last
+    // clear_dirty() are flagged for remeshing.
+    class Chunk {
+    public:
+        static constexpr uint32_t MAX_SECTIONS = 64;
+
+        explicit Chunk(ChunkPos position, uint32_t sectionCount = 16);
+        ~Chunk() = default;
+
+        // Prevent copying
+        Chunk(const Chunk&) = delete;
+        Chunk& operator=(const Chunk&) = delete;
+
+        // Allow moving
+        Chunk(Chunk&&) noexcept = default;
+        Chunk& operator=(Chunk&&) noexcept = default;
+
+        // x and z are local (0-15), y is 0 to get_height() - 1. Out of range reads return air.
+        [[nodiscard]] BlockId get_block(int x, int y, int z) const noexcept;
+        BlockId set_block(int x, int y, int z, BlockId block);
+
+        // Fill the whole column, or the box [min, max) of local coordinates
+        void fill(BlockId block);
+        void fill(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockId block);
+
+        // Section access; get_section() returns nullptr for all-air sections
+        [[nodiscard]] const ChunkSection* get_section(uint32_t index) const noexcept;
+        ChunkSection& get_or_create_section(uint32_t index);
+
+        // Compact every section and free the ones that became all air
+        void compact();
+
+        // Remeshing flags (one bit per section)
+        [[nodiscard]] bool is_section_dirty(uint32_t index) const noexcept { return (m_dirtySections >> index) & 1; }
+        [[nodiscard]] uint64_t get_dirty_sections() const noexcept { return m_dirtySections; }
+        void mark_dirty(uint32_t index) noexcept { m_dirtySections |= uint64_t{1} << index; }
+        void clear_dirty() noexcept { m_dirtySections = 0; }
+
+        // Accessors
+        [[nodiscard]] ChunkPos get_position() const noexcept { return m_position; }
+        [[nodiscard]] uint32_t get_section_count() const noexcept { return static_cast<uint32_t>(m_sections.size()); }
+        [[nodiscard]] int get_height() const noexcept { return static_cast<int>(m_sections.size()) * SECTION_SIZE; }
+        [[nodiscard]] size_t get_memory_usage() const noexcept;
+
+    private:
+        ChunkPos m_position;
+        std::vector<std::unique_ptr<ChunkSection>> m_sections;
+        uint64_t m_dirtySections = 0;
+    };
+
+    // Loaded chunk columns addressed by chunk position, with block access in
+    // world coordinates
+    class ChunkStorage {
+    public:
+        explicit ChunkStorage(uint32_t sectionsPerChunk = 16);
+        ~ChunkStorage() = default;
+
+        // Prevent copying
+        ChunkStorage(const ChunkStorage&) = delete;
+        ChunkStorage& operator=(const ChunkStorage&) = delete;
+
+        // Allow moving
+        ChunkStorage(ChunkStorage&&) noexcept = default;
+        ChunkStorage& operator=(ChunkStorage&&) noexcept = default;
+
+        // Return the chunk at position, creating an empty one if it is not loaded.
+        // Loading or unloading a chunk marks its neighbours' sections dirty.
+        Chunk& load_chunk(ChunkPos position);
+        bool unload_chunk(ChunkPos position);
+        void clear() { m_chunks.clear(); }
+
+        [[nodiscard]] Chunk* get_chunk(ChunkPos position) noexcept;
+        [[nodiscard]] const Chunk* get_chunk(ChunkPos position) const noexcept;
+
+        // World coordinates. Reads from unloaded chunks return air; writes to them return false.
+        [[nodiscard]] BlockId get_block(int x, int y, int z) const noexcept;
+        bool set_block(int x, int y, int z, BlockId block);
+
+        // Chunk containing a world block position
+        [[nodiscard]] static ChunkPos chunk_pos_of(int x, int z) noexcept { return ChunkPos{x >> 4, z >> 4}; }
+
+        template<typename Function>
+        void for_each_chunk(Function&& function) {
+            for (auto& [position, chunk] : m_chunks) {
+                function(*chunk);
+            }
+        }
+
+        // Compact every loaded chunk
+        void compact();
+
+        // Accessors
+        [[nodiscard]] size_t size() const noexcept { return m_chunks.size(); }
+        [[nodiscard]] uint32_t get_sections_per_chunk() const noexcept { return m_sectionsPerChunk; }
+        [[nodiscard]] size_t get_memory_usage() const noexcept;
+
+    private:
+        void mark_neighbours_dirty(ChunkPos position) noexcept;
+
+        uint32_t m_sectionsPerChunk;
+        std::unordered_map<ChunkPos, std::unique_ptr<Chunk>, ChunkPosHash> m_chunks;
+    };
+
+} // namespace minecart::world
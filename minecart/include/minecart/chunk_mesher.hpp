@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+
+#include "minecart/chunk.hpp"
+#include "minecart/job_system.hpp"
+#include "minecart/model.hpp"
+#include "minecart/vertex_layout.hpp"
+
+namespace minecart::world {
+
+    // How a block type is drawn
+    struct BlockVisual {
+        std::array<uint8_t, 4> color{255, 255, 255, 255};
+        bool opaque = true;     // Opaque blocks hide the faces of anything next to them
+    };
+
+    // Blocks of one section plus a one block border taken from the neighbouring
+    // sections and chunks, so the mesher can cull faces without touching the world
+    struct SectionMeshInput {
+        static constexpr int PADDED_SIZE = SECTION_SIZE + 2;
+
+        ChunkPos position;
+        uint32_t section = 0;
+        std::array<BlockId, PADDED_SIZE * PADDED_SIZE * PADDED_SIZE> blocks{};
+
+        // Coordinates range from -1 to 16
+        [[nodiscard]] static constexpr uint32_t index(int x, int y, int z) noexcept {
+            return static_cast<uint32_t>(((y + 1) * PADDED_SIZE + (z + 1)) * PADDED_SIZE + (x + 1));
+        }
+        [[nodiscard]] BlockId get(int x, int y, int z) const noexcept { return blocks[index(x, y, z)]; }
+    };
+
+    // Mesh of one section. Vertex positions are relative to the section origin,
+    // so draw it with a model matrix translated to (chunk x * 16, section * 16, chunk z * 16).
+    struct SectionMesh {
+        ChunkPos position;
+        uint32_t section = 0;
+        std::vector<graphics::VoxelVertex> vertices;
+        std::vector<uint16_t> indices;
+        std::vector<uint32_t> wideIndices;  // Used instead of indices once the vertices outgrow 16-bit indices
+        uint32_t quadCount = 0;
+
+        [[nodiscard]] bool is_empty() const noexcept { return quadCount == 0; }
+        [[nodiscard]] bool is_wide() const noexcept { return !wideIndices.empty(); }
+
+        // Hand the mesh to a model and upload it; returns false (leaving the model
+        // untouched) when there is nothing to draw
+        bool upload_to(graphics::Model& model) const;
+    };
+
+    // Greedy mesher for chunk sections, run on its own worker threads or on a JobSystem.
+    //
+    // enqueue() copies a section and its border on the calling thread, so the world
+    // may change freely while workers mesh. Visible faces are found with bitmask
+    // kernels that test a whole 16-block row per operation, then merged into the
+    // largest rectangles of the same block per slice. Finished meshes are returned
+    // by collect(); hand them back with recycle() so their buffers are reused.
+    class ChunkMesher {
+    public:
+        // Zero threads picks one fewer than the hardware concurrency (at least one)
+        explicit ChunkMesher(uint32_t threadCount = 0);
+
+        // Mesh on the job system's workers instead of private threads
+        explicit ChunkMesher(JobSystem& jobSystem);
+
+        // Waits for sections running on a job system; queued sections are dropped otherwise
+        ~ChunkMesher();
+
+        // Prevent copying and moving (workers hold a pointer to the mesher)
+        ChunkMesher(const ChunkMesher&) = delete;
+        ChunkMesher& operator=(const ChunkMesher&) = delete;
+        ChunkMesher(ChunkMesher&&) = delete;
+        ChunkMesher& operator=(ChunkMesher&&) = delete;
+
+        // Visuals indexed by BlockId; ids past the end are opaque white. Applies to
+        // sections enqueued afterwards.
+        void set_block_visuals(std::vector<BlockVisual> visuals);
+
+        // Queue one section for meshing
+        void enqueue(const ChunkStorage& storage, ChunkPos position, uint32_t section);
+
+        // Queue every dirty section of every loaded chunk, clear the dirty flags and
+        // return how many sections were queued
+        uint32_t enqueue_dirty(ChunkStorage& storage);
+
+        // Append finished meshes to out
+        void collect(std::vector<std::unique_ptr<SectionMesh>>& out);
+
+        // Return a mesh to the pool once its data has been uploaded
+        void recycle(std::unique_ptr<SectionMesh> mesh);
+
+        // Block until every queued section has been meshed
+        void wait();
+
+        [[nodiscard]] size_t get_pending() const;
+        [[nodiscard]] uint32_t get_thread_count() const noexcept;
+
+        // Copy a section and its border out of the world
+        static void gather(const ChunkStorage& storage, ChunkPos position, uint32_t section, SectionMeshInput& out);
+
+        // Mesh one section on the calling thread
+        static void mesh_section(const SectionMeshInput& input, const std::vector<BlockVisual>& visuals, SectionMesh& out);
+
+    private:
+        struct Request {
+            std::unique_ptr<SectionMeshInput> input;
+            std::shared_ptr<const std::vector<BlockVisual>> visuals;
+        };
+
+        // Take the oldest request and a pooled mesh; m_mutex must be held
+        Request take_request(std::unique_ptr<SectionMesh>& mesh);
+        void process(Request& request, std::unique_ptr<SectionMesh> mesh);
+        void worker();
+
+        mutable std::mutex m_mutex;
+        std::condition_variable m_jobAvailable;
+        std::condition_variable m_idle;
+        std::deque<Request> m_requests;
+        std::vector<std::unique_ptr<SectionMesh>> m_finished;
+        std::vector<std::unique_ptr<SectionMeshInput>> m_freeInputs;
+        std::vector<std::unique_ptr<SectionMesh>> m_freeMeshes;
+        std::shared_ptr<const std::vector<BlockVisual>> m_visuals;
+        size_t m_active = 0;
+        bool m_stopping = false;
+        std::vector<std::thread> m_threads;
+        JobSystem* m_jobSystem = nullptr;
+        JobCounter m_counter;                   // Sections in flight on the job system
+    };
+
+} // namespace minecart::world
@@ -6,8 +6,31 @@
 #include <memory>
 
 #include "minecart/camera.hpp"
+#include "minecart/chunk.hpp"
+#include "minecart/chunk_mesher.hpp"
+#include "minecart/buffer_arena.hpp"
+#include "minecart/culling.hpp"
+#include "minecart/draw_list.hpp"
+#include "minecart/frame_arena.hpp"
+#include "minecart/gpu_stats.hpp"
+#include "minecart/hash.hpp"
+#include "minecart/instance_buffer.hpp"
+#include "minecart/job_system.hpp"
+#include "minecart/mesh_optimizer.hpp"
 #include "minecart/model.hpp"
+#include "minecart/pipeline_cache.hpp"
+#include "minecart/profiler.hpp"
+#include "minecart/render_queue.hpp"
+#include "minecart/scene_index.hpp"
 #include "minecart/shader.hpp"
+#include "minecart/shader_cache.hpp"
+#include "minecart/shader_library.hpp"
+#include "minecart/shader_variants.hpp"
+#include "minecart/simulation_thread.hpp"
+#include "minecart/staging_ring.hpp"
+#include "minecart/triple_buffer.hpp"
+#include "minecart/upload_queue.hpp"
+#include "minecart/vertex_layout.hpp"
 #include "minecart/window.hpp"
 
 
@@ -50,6 +73,12 @@ public:
      */
     [[nodiscard]] graphics::Window& get_window();
 
+    /**
+     * @brief Get the job system shared by the engine and the game.
+     * @return Reference to the job system (only valid after run() starts)
+     */
+    [[nodiscard]] JobSystem& get_job_system();
+
     /**
      * @brief Called once after the window and GPU device are initialized.
      * 
@@ -70,6 +99,17 @@ public:
      */
     virtual bool on_render(graphics::FrameContext& frameContext) = 0;
 
+    /**
+     * @brief Called every frame before the render pass begins.
+     *
+     * Uploads queued here are recorded into this frame's command buffer, so
+     * write per-frame GPU data (e.g. a FrameUniformArena) here rather than in
+     * on_render(). The frameContext's renderPass is null.
+     *
+     * @param frameContext Contains the command buffer, window, device and upload queue
+     */
+    virtual void on_prepare_render(graphics::FrameContext& frameContext) {}
+
     /**
      * @brief Called for each SDL event.
      * 
@@ -90,6 +130,56 @@ public:
      */
     virtual bool on_update(float deltaTime) { return true; }
 
+    /**
+     * @brief Length of the fixed simulation step used by on_fixed_update().
+     * @return Step length in seconds (default 1/60); zero disables fixed updates
+     */
+    virtual float get_fixed_timestep() { return 1.0f / 60.0f; }
+
+    /**
+     * @brief Called zero or more times per frame to advance the simulation by
+     * exactly one fixed step.
+     * 
+     * Time left over after the last step is passed to on_render() as
+     * FrameContext::interpolationAlpha, so rendering can blend the previous and
+     * current simulation states. Not called in pipelined mode, where on_tick()
+     * plays this role.
+     * 
+     * @param fixedDeltaTime The fixed step length in seconds
+     * @return true to continue, false to exit
+     */
+    virtual bool on_fixed_update(float fixedDeltaTime) { return true; }
+
+    /**
+     * @brief Whether to run on_tick() on a dedicated simulation thread.
+     * 
+     * In pipelined mode the simulation advances at get_tick_rate() on its own
+     * thread while the main thread handles events, on_update() and rendering,
+     * so swapchain waits and GPU stalls no longer hold back the simulation.
+     * Hand results to on_render() through a TripleBuffer of render snapshots
+     * instead of sharing mutable state.
+     * 
+     * @return true to enable pipelined mode (default false)
+     */
+    virtual bool is_pipelined() { return false; }
+
+    /**
+     * @brief Simulation ticks per second in pipelined mode.
+     * @return Tick rate in Hz (default 60)
+     */
+    virtual double get_tick_rate() { return 60.0; }
+
+    /**
+     * @brief Called at a fixed rate on the simulation thread in pipelined mode.
+     * 
+     * Runs concurrently with on_update() and on_render(); do not touch GPU
+     * resources or ImGui here.
+     * 
+     * @param tickSeconds Fixed tick length in seconds
+     * @return true to continue, false to exit
+     */
+    virtual bool on_tick(double tickSeconds) { return true; }
+
     /**
      * @brief Called every frame to render ImGui content.
      * 
@@ -119,6 +209,7 @@ public:
     virtual std::string get_name() { return "unknown"; }
 
 private:
+    std::unique_ptr<JobSystem> m_jobSystem;  // Declared first so it outlives the window
     std::unique_ptr<graphics::Window> m_window;
 };
 
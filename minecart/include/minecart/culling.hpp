@@ -0,0 +1,101 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <limits>
+#include <cstddef>
+#include <cstdint>
+
+#include "glm/glm.hpp"
+
+namespace minecart::graphics {
+
+    // Axis-aligned bounding box. Default constructed boxes are empty and grow with expand().
+    struct Aabb {
+        glm::vec3 min{std::numeric_limits<float>::max()};
+        glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+        // A box that contains everything (never culled). Finite so SIMD plane tests stay NaN-free.
+        static Aabb everything() noexcept {
+            constexpr float extent = std::numeric_limits<float>::max() / 8.0f;
+            return Aabb{glm::vec3{-extent}, glm::vec3{extent}};
+        }
+
+        [[nodiscard]] bool is_empty() const noexcept { return min.x > max.x || min.y > max.y || min.z > max.z; }
+        [[nodiscard]] glm::vec3 get_center() const noexcept { return (min + max) * 0.5f; }
+        [[nodiscard]] glm::vec3 get_extents() const noexcept { return (max - min) * 0.5f; }
+
+        void expand(const glm::vec3& point) noexcept {
+            min = glm::min(min, point);
+            max = glm::max(max, point);
+        }
+        void expand(const Aabb& other) noexcept {
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+    };
+
+    // Six planes (xyz = inward normal, w = distance) of a view frustum.
+    // A point p is inside a plane when dot(xyz, p) + w >= 0.
+    struct Frustum {
+        enum Plane { Left = 0, Right, Bottom, Top, Near, Far };
+
+        std::array<glm::vec4, 6> planes{};
+
+        // Gribb-Hartmann extraction from a view-projection matrix. The near plane uses
+        // -w <= z, which is exact for [-1, 1] depth and conservative for [0, 1] depth.
+        // With reverseZ the near plane is z <= w and the far plane z >= 0; an
+        // infinite far plane comes out as a plane that contains everything.
+        static Frustum from_matrix(const glm::mat4& viewProjection, bool reverseZ = false);
+
+        [[nodiscard]] bool intersects(const Aabb& box) const noexcept;
+        [[nodiscard]] bool intersects_sphere(const glm::vec3& center, float radius) const noexcept;
+    };
+
+    // Structure-of-arrays bounds for batch culling. Boxes are stored as centre and
+    // extents (plus a bounding-sphere radius) so kernels load 4 or 8 objects per lane.
+    class CullingBounds {
+    public:
+        // Add bounds and return their index
+        uint32_t add(const Aabb& box);
+        void set(uint32_t index, const Aabb& box);
+        void clear();
+        void reserve(size_t count);
+
+        [[nodiscard]] uint32_t size() const noexcept { return static_cast<uint32_t>(m_centerX.size()); }
+
+        // SoA arrays, all size() long
+        [[nodiscard]] const float* center_x() const noexcept { return m_centerX.data(); }
+        [[nodiscard]] const float* center_y() const noexcept { return m_centerY.data(); }
+        [[nodiscard]] const float* center_z() const noexcept { return m_centerZ.data(); }
+        [[nodiscard]] const float* extent_x() const noexcept { return m_extentX.data(); }
+        [[nodiscard]] const float* extent_y() const noexcept { return m_extentY.data(); }
+        [[nodiscard]] const float* extent_z() const noexcept { return m_extentZ.data(); }
+        [[nodiscard]] const float* radius() const noexcept { return m_radius.data(); }
+
+    private:
+        std::vector<float> m_centerX, m_centerY, m_centerZ;
+        std::vector<float> m_extentX, m_extentY, m_extentZ;
+        std::vector<float> m_radius;
+    };
+
+    // Culling kernel implementations, picked at runtime from the CPU's features
+    enum class CullingKernel {
+        Scalar,
+        SSE2,
+        AVX2
+    };
+
+    // Append indices of boxes / bounding spheres that intersect the frustum to
+    // visible (cleared first) and return how many there are
+    uint32_t cull_boxes(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible);
+    uint32_t cull_spheres(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible);
+
+    // Kernel used by cull_boxes/cull_spheres. set_culling_kernel() falls back to the
+    // best supported kernel if the requested one is unavailable.
+    [[nodiscard]] CullingKernel get_culling_kernel() noexcept;
+    void set_culling_kernel(CullingKernel kernel) noexcept;
+    [[nodiscard]] bool is_culling_kernel_supported(CullingKernel kernel) noexcept;
+    [[nodiscard]] const char* get_culling_kernel_name(CullingKernel kernel) noexcept;
+
+} // namespace minecart::graphics
@@ -0,0 +1,101 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+
+#include "minecart/model.hpp"
+#include "minecart/upload_queue.hpp"
+
+namespace minecart::graphics {
+
+    // Exception class for draw list errors
+    class DrawListException : public std::runtime_error {
+    public:
+        explicit DrawListException(const std::string& message)
+            : std::runtime_error("Draw list error: " + message) {}
+    };
+
+    // Counters describing the last built draw list
+    struct DrawListStats {
+        uint32_t draws = 0;         // Draw commands packed into the indirect buffer
+        uint32_t calls = 0;         // Indirect draw calls issued by render()
+        uint32_t skipped = 0;       // Models without uploaded geometry at build time
+    };
+
+    // GPU-driven multi-draw for static geometry. Models that share a pipeline are
+    // added once; upload() packs their draw arguments into an indirect buffer,
+    // grouped by vertex/index buffer, and render() issues one indirect call per
+    // group. Models placed in the same GpuBufferArena page collapse into a single
+    // call, so CPU cost per frame is independent of the model count.
+    //
+    // Draw arguments are resolved at upload(); call it again after models are
+    // re-uploaded into new storage or the arena is defragmented.
+    class DrawList {
+    public:
+        // Constructor - takes non-owning pointers to device and (optionally) the upload
+        // queue. Without a queue, upload() submits its copy immediately.
+        explicit DrawList(SDL_GPUDevice* device, UploadQueue* uploadQueue = nullptr);
+        ~DrawList() = default;
+
+        // Prevent copying
+        DrawList(const DrawList&) = delete;
+        DrawList& operator=(const DrawList&) = delete;
+
+        // Allow moving
+        DrawList(DrawList&&) noexcept = default;
+        DrawList& operator=(DrawList&&) noexcept = default;
+
+        // Add a model (non-owning; it must outlive the list or be removed with clear())
+        void add(const Model& model, uint32_t instanceCount = 1, uint32_t firstInstance = 0);
+        void clear();
+
+        // Resolve draw arguments and upload them to the indirect buffer
+        void upload();
+
+        // Issue the indirect draws (pipeline must already be bound with uniforms set)
+        void render(SDL_GPURenderPass* renderPass) const;
+
+        // Check if the indirect buffer has been recorded and the list can be drawn
+        [[nodiscard]] bool is_ready() const noexcept;
+
+        // Accessors
+        [[nodiscard]] size_t size() const noexcept { return m_entries.size(); }
+        [[nodiscard]] const DrawListStats& get_stats() const noexcept { return m_stats; }
+
+    private:
+        struct Entry {
+            const Model* model;
+            uint32_t instanceCount;
+            uint32_t firstInstance;
+        };
+
+        // Consecutive commands drawn with the same bindings
+        struct Run {
+            SDL_GPUBuffer* vertexBuffer = nullptr;
+            SDL_GPUBuffer* indexBuffer = nullptr;
+            SDL_GPUIndexElementSize indexElementSize = SDL_GPU_INDEXELEMENTSIZE_32BIT;
+            uint32_t offset = 0;        // Byte offset of the first command in the indirect buffer
+            uint32_t drawCount = 0;
+        };
+
+        void ensure_storage(uint32_t size);
+
+        SDL_GPUDevice* m_device;        // Non-owning
+        UploadQueue* m_uploadQueue;     // Non-owning, may be null
+
+        std::vector<Entry> m_entries;
+        std::vector<Run> m_runs;
+        std::vector<std::byte> m_commands;
+
+        GPUBufferPtr m_indirectBuffer;
+        uint32_t m_capacity = 0;        // Bytes
+        uint64_t m_uploadTicket = 0;
+        DrawListStats m_stats;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "minecart/model.hpp"
+#include "minecart/upload_queue.hpp"
+#include "minecart/vertex_layout.hpp"
+
+namespace minecart::graphics {
+
+    // Exception class for frame arena errors
+    class FrameArenaException : public std::runtime_error {
+    public:
+        explicit FrameArenaException(const std::string& message)
+            : std::runtime_error("Frame arena error: " + message) {}
+    };
+
+    // Per-instance record index read from an instance-rate vertex buffer holding
+    // 0, 1, 2, ... Draws pass an arena allocation's first record as firstInstance,
+    // which offsets instance-rate attributes on every backend (SV_InstanceID does
+    // not include it), so the shader reads objects[index] from location 9.
+    struct FrameDataIndex {
+        uint32_t index;
+    };
+
+    template<>
+    struct VertexLayout<FrameDataIndex> {
+        static constexpr std::array attributes{
+            vertex_attribute(9, SDL_GPU_VERTEXELEMENTFORMAT_UINT, offsetof(FrameDataIndex, index)),
+        };
+    };
+
+    // Type-erased per-frame linear arena of fixed-size records in a GPU storage
+    // buffer. Records are bump-allocated on the CPU while building the frame and
+    // sent with a single upload; begin_frame() starts over at record 0.
+    //
+    // The upload cycles the buffer, so frames still in flight keep reading their
+    // own copy while this frame's data is written; the buffer grows (never shrinks)
+    // to the busiest frame seen so far.
+    class FrameUniformArenaBase {
+    public:
+        // Constructor - takes non-owning pointers to device and (optionally) the upload
+        // queue. Without a queue, upload() submits its copy immediately.
+        FrameUniformArenaBase(SDL_GPUDevice* device, UploadQueue* uploadQueue, uint32_t stride);
+        ~FrameUniformArenaBase() = default;
+
+        // Prevent copying
+        FrameUniformArenaBase(const FrameUniformArenaBase&) = delete;
+        FrameUniformArenaBase& operator=(const FrameUniformArenaBase&) = delete;
+
+        // Allow moving
+        FrameUniformArenaBase(FrameUniformArenaBase&&) noexcept = default;
+        FrameUniformArenaBase& operator=(FrameUniformArenaBase&&) noexcept = default;
+
+        // Discard last frame's records
+        void begin_frame() noexcept;
+
+        // Upload every record allocated this frame; call before the frame's uploads
+        // are recorded (Game::on_prepare_render)
+        void upload();
+
+        // Bind the records as a vertex storage buffer and the FrameDataIndex stream
+        // as an instance-rate vertex buffer
+        void bind(SDL_GPURenderPass* renderPass, uint32_t storageSlot = 0, uint32_t indexSlot = 1) const;
+
+        // Bind the records as a fragment storage buffer
+        void bind_fragment(SDL_GPURenderPass* renderPass, uint32_t storageSlot = 0) const;
+
+        // Check if this frame's upload has been recorded and the records can be read
+        [[nodiscard]] bool is_ready() const noexcept;
+
+        // Accessors
+        [[nodiscard]] SDL_GPUBuffer* get_buffer() const noexcept { return m_buffer.get(); }
+        [[nodiscard]] SDL_GPUBuffer* get_index_buffer() const noexcept { return m_indexBuffer.get(); }
+        [[nodiscard]] uint32_t get_count() const noexcept { return m_count; }
+        [[nodiscard]] uint32_t get_capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] uint32_t get_stride() const noexcept { return m_stride; }
+        [[nodiscard]] uint64_t get_uploaded_bytes() const noexcept { return m_uploadedBytes; }
+
+    protected:
+        // Reserve count records and return the index of the first
+        uint32_t allocate_records(uint32_t count);
+        [[nodiscard]] std::byte* record(uint32_t index) noexcept { return m_data.data() + static_cast<size_t>(index) * m_stride; }
+
+        uint32_t m_count = 0;
+
+    private:
+        void ensure_storage();
+        void enqueue(SDL_GPUBuffer* buffer, std::span<const std::byte> data, bool cycle);
+
+        SDL_GPUDevice* m_device;        // Non-owning
+        UploadQueue* m_uploadQueue;     // Non-owning, may be null
+        uint32_t m_stride;
+
+        std::vector<std::byte> m_data;
+        GPUBufferPtr m_buffer;
+        GPUBufferPtr m_indexBuffer;
+        uint32_t m_capacity = 0;
+        uint64_t m_uploadTicket = 0;
+        uint64_t m_uploadedBytes = 0;
+    };
+
+    // Records handed out by FrameUniformArena::allocate(). data is only valid until
+    // the next allocation.
+    template<typename T>
+    struct FrameAllocation {
+        uint32_t first = 0;     // Pass as firstInstance
+        std::span<T> data;
+    };
+
+    // Typed view over FrameUniformArenaBase. T must be trivially copyable and match
+    // the shader's structured buffer layout:
+    //
+    //     arena.begin_frame();
+    //     for (Object& object : objects) {
+    //         object.firstInstance = arena.push({object.transform, object.color});
+    //     }
+    //     arena.upload();
+    //     ...
+    //     arena.bind(renderPass);
+    //     model.render_instanced(renderPass, 1, object.firstInstance);
+    template<typename T>
+    class FrameUniformArena : public FrameUniformArenaBase {
+        static_assert(std::is_trivially_copyable_v<T>, "Frame data must be trivially copyable");
+
+    public:
+        explicit FrameUniformArena(SDL_GPUDevice* device, UploadQueue* uploadQueue = nullptr)
+            : FrameUniformArenaBase(device, uploadQueue, sizeof(T)) {}
+
+        // Append one record and return its index
+        uint32_t push(const T& value) {
+            uint32_t index = allocate_records(1);
+            std::memcpy(record(index), &value, sizeof(T));
+            return index;
+        }
+
+        // Reserve count consecutive records (e.g. one per instance) to fill in place
+        FrameAllocation<T> allocate(uint32_t count) {
+            uint32_t first = allocate_records(count);
+            return FrameAllocation<T>{first, std::span<T>(reinterpret_cast<T*>(record(first)), count)};
+        }
+    };
+
+} // namespace minecart::graphics
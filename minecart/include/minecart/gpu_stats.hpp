@@ -0,0 +1,129 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <atomic>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+#include <cstdint>
+
+namespace minecart::graphics {
+
+    // Exception class for GPU statistics errors
+    class GpuStatsException : public std::runtime_error {
+    public:
+        explicit GpuStatsException(const std::string& message)
+            : std::runtime_error("GPU stats error: " + message) {}
+    };
+
+    // GPU work submitted during one frame, plus the resources alive at its end
+    struct GpuFrameStats {
+        uint64_t frame = 0;
+        uint64_t drawCalls = 0;             // Indirect draws count once per command
+        uint64_t primitives = 0;            // Triangles of direct draws (triangle lists assumed)
+        uint64_t pipelineBinds = 0;
+        uint64_t bufferBinds = 0;           // Vertex, index and storage buffer bindings
+        uint64_t uniformPushes = 0;
+        uint64_t uniformBytes = 0;
+        uint64_t bytesUploaded = 0;
+        uint64_t transferBuffersCreated = 0;
+
+        uint64_t liveBuffers = 0;
+        uint64_t liveBufferBytes = 0;
+        uint64_t liveShaders = 0;
+        uint64_t liveShaderBytes = 0;       // SPIR-V size the shaders were created from
+    };
+
+    // Process-wide counters for GPU workload, updated by Model, Shader, the render
+    // queues and the upload path and rolled over by Window::render_frame(). Per-draw
+    // counters are relaxed atomic adds; only resource creation and release take a
+    // lock, to remember each resource's size.
+    class GpuStats {
+    public:
+        static constexpr uint32_t HISTORY = 240;
+
+        [[nodiscard]] static GpuStats& get();
+
+        // Prevent copying and moving
+        GpuStats(const GpuStats&) = delete;
+        GpuStats& operator=(const GpuStats&) = delete;
+
+        // Per-frame counters
+        void add_draw(uint32_t vertexCount, uint32_t instanceCount) noexcept {
+            m_drawCalls.fetch_add(1, std::memory_order_relaxed);
+            m_primitives.fetch_add(static_cast<uint64_t>(vertexCount / 3) * instanceCount, std::memory_order_relaxed);
+        }
+        void add_indirect_draws(uint32_t drawCount) noexcept { m_drawCalls.fetch_add(drawCount, std::memory_order_relaxed); }
+        void add_pipeline_bind() noexcept { m_pipelineBinds.fetch_add(1, std::memory_order_relaxed); }
+        void add_buffer_binds(uint32_t count) noexcept { m_bufferBinds.fetch_add(count, std::memory_order_relaxed); }
+        void add_uniform_push(uint32_t bytes) noexcept {
+            m_uniformPushes.fetch_add(1, std::memory_order_relaxed);
+            m_uniformBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+        void add_upload(uint64_t bytes) noexcept { m_bytesUploaded.fetch_add(bytes, std::memory_order_relaxed); }
+        void add_transfer_buffer() noexcept { m_transferBuffersCreated.fetch_add(1, std::memory_order_relaxed); }
+
+        // Live resources; releasing an untracked resource is ignored
+        void track_buffer(const SDL_GPUBuffer* buffer, uint64_t bytes);
+        void untrack_buffer(const SDL_GPUBuffer* buffer) noexcept;
+        void track_shader(const SDL_GPUShader* shader, uint64_t bytes);
+        void untrack_shader(const SDL_GPUShader* shader) noexcept;
+
+        // Close the current frame: publish its counters, reset them and emit the
+        // periodic log line and CSV row (main thread)
+        void end_frame();
+
+        // Log a summary every interval frames (0 = never)
+        void set_log_interval(uint32_t frames) noexcept { m_logInterval = frames; }
+
+        // Append one row per frame to a CSV file until stop_csv()
+        void start_csv(const std::string& path);
+        void stop_csv();
+
+        // Draw the statistics panel into the current ImGui frame (when visible)
+        void draw_panel();
+
+        // Accessors
+        [[nodiscard]] const GpuFrameStats& get_last_frame() const noexcept { return m_lastFrame; }
+        [[nodiscard]] const std::array<GpuFrameStats, HISTORY>& get_history() const noexcept { return m_history; }
+        [[nodiscard]] uint64_t get_live_buffer_bytes() const noexcept { return m_liveBufferBytes.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool is_panel_visible() const noexcept { return m_panelVisible; }
+        [[nodiscard]] bool is_recording_csv() const noexcept { return m_csv.is_open(); }
+
+        // Modifiers
+        void set_panel_visible(bool visible) noexcept { m_panelVisible = visible; }
+
+    private:
+        GpuStats() = default;
+
+        std::atomic<uint64_t> m_drawCalls{0};
+        std::atomic<uint64_t> m_primitives{0};
+        std::atomic<uint64_t> m_pipelineBinds{0};
+        std::atomic<uint64_t> m_bufferBinds{0};
+        std::atomic<uint64_t> m_uniformPushes{0};
+        std::atomic<uint64_t> m_uniformBytes{0};
+        std::atomic<uint64_t> m_bytesUploaded{0};
+        std::atomic<uint64_t> m_transferBuffersCreated{0};
+
+        std::mutex m_resourceMutex;
+        std::unordered_map<const void*, uint64_t> m_bufferSizes;
+        std::unordered_map<const void*, uint64_t> m_shaderSizes;
+        std::atomic<uint64_t> m_liveBuffers{0};
+        std::atomic<uint64_t> m_liveBufferBytes{0};
+        std::atomic<uint64_t> m_liveShaders{0};
+        std::atomic<uint64_t> m_liveShaderBytes{0};
+
+        // Main thread only
+        uint64_t m_frame = 0;
+        GpuFrameStats m_lastFrame;
+        std::array<GpuFrameStats, HISTORY> m_history{};
+        uint32_t m_logInterval = 0;
+        std::ofstream m_csv;
+        bool m_panelVisible = false;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace minecart {
+
+    // 64-bit FNV-1a. Stable across runs and platforms, so it is used for keys that
+    // are persisted or compared between sessions (cache files, library names).
+    constexpr uint64_t FNV1A_OFFSET = 14695981039346656037ull;
+    constexpr uint64_t FNV1A_PRIME = 1099511628211ull;
+
+    // Hash size bytes at data, continuing from hash
+    inline uint64_t fnv1a(const void* data, size_t size, uint64_t hash = FNV1A_OFFSET) noexcept {
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        for (size_t i = 0; i < size; ++i) {
+            hash = (hash ^ bytes[i]) * FNV1A_PRIME;
+        }
+        return hash;
+    }
+
+    inline uint64_t fnv1a(std::string_view value, uint64_t hash = FNV1A_OFFSET) noexcept {
+        return fnv1a(value.data(), value.size(), hash);
+    }
+
+} // namespace minecart
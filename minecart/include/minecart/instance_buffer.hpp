@@ -0,0 +1,175 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "minecart/model.hpp"
+#include "minecart/upload_queue.hpp"
+#include "minecart/vertex_layout.hpp"
+
+namespace minecart::graphics {
+
+    // Exception class for instance buffer errors
+    class InstanceBufferException : public std::runtime_error {
+    public:
+        explicit InstanceBufferException(const std::string& message)
+            : std::runtime_error("Instance buffer error: " + message) {}
+    };
+
+    // How the shader reads per-instance data
+    enum class InstanceBufferUsage {
+        Vertex,     // Instance-rate vertex buffer in slot 1 (see instanced_vertex_input_state)
+        Storage     // Vertex storage buffer, indexed with SV_InstanceID
+    };
+
+    // Per-instance transform and color. As an instance-rate vertex buffer the
+    // matrix rows use locations 4-7 and the color location 8, leaving 0-3 for
+    // per-vertex attributes. As a storage buffer it is a StructuredBuffer of
+    // { float4x4 model; float4 color; }.
+    struct InstanceTransform {
+        float model[16];    // Column-major, as glm::mat4
+        float color[4];     // r, g, b, a
+    };
+
+    template<>
+    struct VertexLayout<InstanceTransform> {
+        static constexpr std::array attributes{
+            vertex_attribute(4, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(InstanceTransform, model) + 0 * sizeof(float)),
+            vertex_attribute(5, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(InstanceTransform, model) + 4 * sizeof(float)),
+            vertex_attribute(6, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(InstanceTransform, model) + 8 * sizeof(float)),
+            vertex_attribute(7, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(InstanceTransform, model) + 12 * sizeof(float)),
+            vertex_attribute(8, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(InstanceTransform, color)),
+        };
+    };
+
+    // Type-erased GPU buffer of fixed-size instance records. Edits on the CPU copy
+    // extend a dirty range; upload() sends only that range (or the whole buffer,
+    // with cycling, when it grows or everything changed).
+    class InstanceBufferBase {
+    public:
+        // Constructor - takes non-owning pointers to device and (optionally) the upload
+        // queue. Without a queue, upload() submits its copy immediately.
+        InstanceBufferBase(SDL_GPUDevice* device, UploadQueue* uploadQueue, uint32_t stride, InstanceBufferUsage usage);
+        ~InstanceBufferBase() = default;
+
+        // Prevent copying
+        InstanceBufferBase(const InstanceBufferBase&) = delete;
+        InstanceBufferBase& operator=(const InstanceBufferBase&) = delete;
+
+        // Allow moving
+        InstanceBufferBase(InstanceBufferBase&&) noexcept = default;
+        InstanceBufferBase& operator=(InstanceBufferBase&&) noexcept = default;
+
+        // Upload the dirty range (no-op when nothing changed)
+        void upload();
+
+        // Bind as a vertex buffer or vertex storage buffer at slot, depending on usage
+        void bind(SDL_GPURenderPass* renderPass, uint32_t slot) const;
+
+        // Check if the last upload has been recorded and the buffer can be drawn from.
+        // Only the first get_uploaded_count() instances are valid on the GPU.
+        [[nodiscard]] bool is_ready() const noexcept;
+
+        // Accessors
+        [[nodiscard]] SDL_GPUBuffer* get_buffer() const noexcept { return m_buffer.get(); }
+        [[nodiscard]] InstanceBufferUsage get_usage() const noexcept { return m_usage; }
+        [[nodiscard]] uint32_t get_count() const noexcept { return m_count; }
+        [[nodiscard]] uint32_t get_uploaded_count() const noexcept { return m_uploadedCount; }
+        [[nodiscard]] uint32_t get_capacity() const noexcept { return m_capacity; }
+        [[nodiscard]] uint32_t get_stride() const noexcept { return m_stride; }
+        [[nodiscard]] bool is_dirty() const noexcept { return m_dirtyBegin < m_dirtyEnd; }
+        [[nodiscard]] uint64_t get_uploaded_bytes() const noexcept { return m_uploadedBytes; }
+
+    protected:
+        void mark_dirty(uint32_t first, uint32_t count) noexcept;
+        void resize_records(uint32_t count);
+        [[nodiscard]] std::byte* record(uint32_t index) noexcept { return m_data.data() + static_cast<size_t>(index) * m_stride; }
+        [[nodiscard]] const std::byte* record(uint32_t index) const noexcept { return m_data.data() + static_cast<size_t>(index) * m_stride; }
+
+        uint32_t m_count = 0;
+
+    private:
+        void ensure_storage();
+
+        SDL_GPUDevice* m_device;        // Non-owning
+        UploadQueue* m_uploadQueue;     // Non-owning, may be null
+        uint32_t m_stride;
+        InstanceBufferUsage m_usage;
+
+        std::vector<std::byte> m_data;
+        GPUBufferPtr m_buffer;
+        uint32_t m_capacity = 0;
+        uint32_t m_uploadedCount = 0;   // Leading instances the GPU buffer holds (at most m_count)
+        uint32_t m_dirtyBegin = 0;
+        uint32_t m_dirtyEnd = 0;
+        uint64_t m_uploadTicket = 0;
+        uint64_t m_uploadedBytes = 0;
+    };
+
+    // Typed view over InstanceBufferBase. T must be trivially copyable; for storage
+    // usage it must also match the shader's structured buffer layout.
+    template<typename T>
+    class InstanceBuffer : public InstanceBufferBase {
+        static_assert(std::is_trivially_copyable_v<T>, "Instance data must be trivially copyable");
+
+    public:
+        explicit InstanceBuffer(SDL_GPUDevice* device, UploadQueue* uploadQueue = nullptr,
+                                InstanceBufferUsage usage = InstanceBufferUsage::Vertex)
+            : InstanceBufferBase(device, uploadQueue, sizeof(T), usage) {}
+
+        // Replace all instances
+        void assign(std::span<const T> instances) {
+            resize_records(static_cast<uint32_t>(instances.size()));
+            if (!instances.empty()) {
+                std::memcpy(record(0), instances.data(), instances.size_bytes());
+            }
+            mark_dirty(0, m_count);
+        }
+
+        // Append an instance and return its index
+        uint32_t push_back(const T& instance) {
+            uint32_t index = m_count;
+            resize_records(m_count + 1);
+            set(index, instance);
+            return index;
+        }
+
+        void set(uint32_t index, const T& instance) {
+            if (index >= m_count) {
+                throw InstanceBufferException("Instance index out of range");
+            }
+            std::memcpy(record(index), &instance, sizeof(T));
+            mark_dirty(index, 1);
+        }
+
+        [[nodiscard]] T get(uint32_t index) const {
+            if (index >= m_count) {
+                throw InstanceBufferException("Instance index out of range");
+            }
+            T instance;
+            std::memcpy(&instance, record(index), sizeof(T));
+            return instance;
+        }
+
+        // Shrink or grow the instance count (new instances are zeroed)
+        void resize(uint32_t count) {
+            uint32_t oldCount = m_count;
+            resize_records(count);
+            if (count > oldCount) {
+                mark_dirty(oldCount, count - oldCount);
+            }
+        }
+
+        void clear() { resize_records(0); }
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <deque>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <stdexcept>
+#include <functional>
+#include <condition_variable>
+#include <cstdint>
+
+namespace minecart {
+
+    // Exception class for job system errors
+    class JobSystemException : public std::runtime_error {
+    public:
+        explicit JobSystemException(const std::string& message)
+            : std::runtime_error("Job system error: " + message) {}
+    };
+
+    using Job = std::function<void()>;
+
+    // Number of outstanding jobs. Every job submitted with a counter increments it
+    // and decrements it when it finishes; jobs submitted "after" a counter start
+    // once it reaches zero. The counter must outlive the jobs that reference it:
+    // call JobSystem::wait() on it before destroying it, even if is_done().
+    class JobCounter {
+    public:
+        JobCounter() = default;
+
+        // Prevent copying and moving (jobs hold a pointer to the counter)
+        JobCounter(const JobCounter&) = delete;
+        JobCounter& operator=(const JobCounter&) = delete;
+
+        [[nodiscard]] bool is_done() const noexcept { return m_pending.load(std::memory_order_acquire) == 0; }
+        [[nodiscard]] uint32_t get_pending() const noexcept { return m_pending.load(std::memory_order_acquire); }
+
+    private:
+        friend class JobSystem;
+
+        struct Continuation {
+            Job job;
+            JobCounter* counter;
+            bool mainThread;
+        };
+
+        std::atomic<uint32_t> m_pending{0};
+        std::mutex m_mutex;
+        std::vector<Continuation> m_continuations;
+    };
+
+    // Pool of worker threads, one per core by default, each with its own deque.
+    // Workers run their newest job first and steal the oldest job of another worker
+    // when they run dry, so related work stays on one core while load still spreads.
+    //
+    // Main-thread jobs never run on a worker: they queue until the main loop calls
+    // run_main_thread_jobs() (once per frame, before rendering), which makes them
+    // the place for GPU uploads and other SDL calls that follow worker results.
+    class JobSystem {
+    public:
+        // Zero workers picks one fewer than the hardware concurrency (at least one).
+        // The constructing thread becomes the main thread.
+        explicit JobSystem(uint32_t workerCount = 0);
+
+        // Stops the workers; jobs still queued are dropped, so wait for counters first
+        ~JobSystem();
+
+        // Prevent copying and moving (workers hold a pointer to the job system)
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+        JobSystem(JobSystem&&) = delete;
+        JobSystem& operator=(JobSystem&&) = delete;
+
+        // Run a job on a worker
+        void submit(Job job, JobCounter* counter = nullptr);
+
+        // Run a job on the main thread during run_main_thread_jobs()
+        void submit_main(Job job, JobCounter* counter = nullptr);
+
+        // Run a job on a worker / the main thread once dependency reaches zero
+        void submit_after(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+        void submit_main_after(JobCounter& dependency, Job job, JobCounter* counter = nullptr);
+
+        // Block until counter reaches zero, running queued jobs meanwhile (including
+        // main-thread jobs when called from the main thread)
+        void wait(JobCounter& counter);
+
+        // Split [0, count) into ranges of grain items (0 = automatic) and call
+        // function(begin, end) for each on the workers. The first overload waits; the
+        // second signals counter when every range is done.
+        void parallel_for(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& function);
+        void parallel_for(uint32_t count, uint32_t grain, std::function<void(uint32_t, uint32_t)> function, JobCounter& counter);
+
+        // Run the main-thread jobs queued so far and return how many ran
+        uint32_t run_main_thread_jobs();
+
+        // Accessors
+        [[nodiscard]] uint32_t get_worker_count() const noexcept { return static_cast<uint32_t>(m_workers.size()); }
+        [[nodiscard]] bool is_main_thread() const noexcept { return std::this_thread::get_id() == m_mainThread; }
+
+    private:
+        struct Task {
+            Job job;
+            JobCounter* counter = nullptr;
+        };
+
+        struct WorkerQueue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void schedule(Task task, bool mainThread);
+        void add_dependency(JobCounter& dependency, Job job, JobCounter* counter, bool mainThread);
+        bool try_run_one(uint32_t preferredQueue);
+        void execute(Task& task);
+        void finish(JobCounter* counter);
+        uint32_t grain_for(uint32_t count, uint32_t grain) const noexcept;
+        void worker(uint32_t index);
+
+        std::vector<std::unique_ptr<WorkerQueue>> m_queues;
+        std::atomic<uint32_t> m_nextQueue{0};       // Round robin for jobs submitted off the workers
+        std::atomic<uint32_t> m_queuedTasks{0};
+
+        std::mutex m_mainMutex;
+        std::deque<Task> m_mainTasks;
+        std::thread::id m_mainThread;
+
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wake;
+        bool m_stopping = false;
+        std::vector<std::thread> m_workers;
+    };
+
+} // namespace minecart
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace minecart::graphics {
+
+    // Exception class for mesh optimisation errors
+    class MeshOptimizerException : public std::runtime_error {
+    public:
+        explicit MeshOptimizerException(const std::string& message)
+            : std::runtime_error("Mesh optimizer error: " + message) {}
+    };
+
+    // Post-transform vertex cache behaviour of an index buffer (FIFO cache simulation)
+    struct VertexCacheStats {
+        uint32_t vertexTransforms = 0;  // Cache misses, i.e. vertex shader invocations
+        float acmr = 0.0f;              // Average cache miss ratio: transforms per triangle (0.5 - 3.0)
+        float atvr = 0.0f;              // Average transform to vertex ratio: transforms per vertex (1.0 is ideal)
+    };
+
+    // Result of MeshOptimizer::optimize()
+    struct MeshOptimizerReport {
+        uint32_t verticesBefore = 0;
+        uint32_t verticesAfter = 0;
+        uint32_t triangles = 0;
+        VertexCacheStats before;
+        VertexCacheStats after;
+    };
+
+    // CPU mesh optimisation for triangle lists. Vertices are treated as opaque
+    // records of `stride` bytes, so any vertex layout can be processed.
+    //
+    // The full pipeline (optimize()) runs, in order:
+    //   1. deduplication of bitwise-identical vertices (also builds indices for
+    //      non-indexed input)
+    //   2. triangle reordering for post-transform cache locality (Forsyth)
+    //   3. cluster reordering to reduce overdraw, when vertex positions are given
+    //   4. vertex reordering for fetch locality, dropping unreferenced vertices
+    class MeshOptimizer {
+    public:
+        struct Options {
+            bool deduplicate = true;
+            bool optimizeVertexCache = true;
+            bool optimizeOverdraw = true;       // Skipped without positions
+            bool optimizeVertexFetch = true;
+            uint32_t cacheSize = 32;    // Simulated cache entries, for scoring and statistics
+            float overdrawThreshold = 1.05f;    // ACMR the overdraw pass may give up, as a factor (>= 1)
+        };
+
+        MeshOptimizer() = default;
+        explicit MeshOptimizer(const Options& options) : m_options(options) {}
+
+        // Optimise vertex data and indices in place. Empty indices mean the
+        // vertices are a non-indexed triangle list; indices are generated.
+        // positions (one per vertex, or empty) enable the overdraw pass.
+        MeshOptimizerReport optimize(std::vector<std::byte>& vertices, uint32_t stride, std::vector<uint32_t>& indices,
+                                     std::span<const std::array<float, 3>> positions = {}) const;
+
+        // Merge identical vertices. Returns the unique vertex count; remap[i] is the
+        // new index of old vertex i.
+        static uint32_t generate_vertex_remap(std::span<const std::byte> vertices, uint32_t stride, std::vector<uint32_t>& remap);
+
+        // Reorder triangles to maximise post-transform vertex cache hits
+        static void optimize_vertex_cache(std::span<uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize = 32);
+
+        // Reorder clusters of cache-optimised triangles so outward-facing ones on the
+        // outside of the mesh are drawn first (front faces are counter-clockwise). Clusters
+        // are cut where the cache ACMR allows, so the result stays within threshold of
+        // the input's ACMR.
+        static void optimize_overdraw(std::span<uint32_t> indices, std::span<const std::array<float, 3>> positions,
+                                      uint32_t cacheSize = 32, float threshold = 1.05f);
+
+        // Reorder vertices into first-use order and drop unreferenced ones. Returns the new vertex count.
+        static uint32_t optimize_vertex_fetch(std::vector<std::byte>& vertices, uint32_t stride, std::span<uint32_t> indices);
+
+        // Simulate a FIFO post-transform cache
+        [[nodiscard]] static VertexCacheStats analyze_vertex_cache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize = 32);
+
+        [[nodiscard]] const Options& get_options() const noexcept { return m_options; }
+
+    private:
+        Options m_options;
+    };
+
+} // namespace minecart::graphics
@@ -2,27 +2,29 @@
 
 #include <SDL3/SDL.h>
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <vector>
 #include <string>
 #include <stdexcept>
 #include <memory>
 #include <cstdint>
 #include <span>
+#include <ranges>
+
+#include "minecart/buffer_arena.hpp"
+#include "minecart/culling.hpp"
+#include "minecart/gpu_stats.hpp"
+#include "minecart/mesh_optimizer.hpp"
+#include "minecart/upload_queue.hpp"
+#include "minecart/vertex_layout.hpp"
 
 namespace minecart::graphics {
 
     // Forward declarations
     class Shader;
-
-    // Vertex structure for 3D models
-    struct Vertex {
-        float position[3];  // x, y, z
-        float color[4];     // r, g, b, a
-
-        Vertex() = default;
-        Vertex(float x, float y, float z, float r, float g, float b, float a = 1.0f)
-            : position{x, y, z}, color{r, g, b, a} {}
-    };
+    class InstanceBufferBase;
 
     // Exception class for model-related errors
     class ModelException : public std::runtime_error {
@@ -31,11 +33,16 @@ namespace minecart::graphics {
             : std::runtime_error("Model error: " + message) {}
     };
 
-    // Custom deleter for SDL GPU buffer
+    // Custom deleter for SDL GPU buffer (drops pending uploads before releasing)
     struct SDLGPUBufferDeleter {
         SDL_GPUDevice* device = nullptr;
+        UploadQueue* uploadQueue = nullptr;
         void operator()(SDL_GPUBuffer* buffer) const noexcept {
+            if (buffer && uploadQueue) {
+                uploadQueue->discard(buffer);
+            }
             if (buffer && device) {
+                GpuStats::get().untrack_buffer(buffer);
                 SDL_ReleaseGPUBuffer(device, buffer);
             }
         }
@@ -44,10 +51,25 @@ namespace minecart::graphics {
     // Type alias for managed buffer
     using GPUBufferPtr = std::unique_ptr<SDL_GPUBuffer, SDLGPUBufferDeleter>;
 
+    // Buffers and ranges a model draws from, for batching draws outside Model
+    // (indirect draw lists, render queues). Invalid until the model is uploaded,
+    // and changes when storage grows or the arena is defragmented.
+    struct ModelDrawInfo {
+        SDL_GPUBuffer* vertexBuffer = nullptr;
+        SDL_GPUBuffer* indexBuffer = nullptr;   // Null for non-indexed draws
+        SDL_GPUIndexElementSize indexElementSize = SDL_GPU_INDEXELEMENTSIZE_32BIT;
+        uint32_t first = 0;         // First index, or first vertex when non-indexed
+        uint32_t count = 0;         // Index count, or vertex count when non-indexed
+        int32_t baseVertex = 0;     // Added to each index
+    };
+
     class Model {
     public:
-        // Constructor - takes non-owning pointer to device
-        explicit Model(SDL_GPUDevice* device);
+        // Constructor - takes non-owning pointers to device and (optionally) the upload queue
+        // and a buffer arena. Without a queue, upload() records both buffers into one copy
+        // pass and submits immediately. With an arena, vertex and index data are placed in
+        // the arena's shared buffers instead of buffers owned by this model.
+        explicit Model(SDL_GPUDevice* device, UploadQueue* uploadQueue = nullptr, GpuBufferArena* arena = nullptr);
         ~Model() = default;
 
         // Prevent copying
@@ -58,40 +80,164 @@ namespace minecart::graphics {
         Model(Model&&) noexcept = default;
         Model& operator=(Model&&) noexcept = default;
 
-        // Set mesh data (vertices and optional indices)
-        void set_vertices(std::span<const Vertex> vertices);
+        // Set mesh data (vertices and optional indices). Any vertex type with a
+        // VertexLayout specialisation is accepted; the model stores raw bytes plus stride.
+        // Bounds are computed (and overdraw optimised) when the layout can decode positions.
+        template<std::ranges::contiguous_range R>
+            requires HasVertexLayout<std::ranges::range_value_t<R>>
+        void set_vertices(const R& vertices) {
+            using V = std::ranges::range_value_t<R>;
+            set_vertex_data(std::as_bytes(std::span<const V>(vertices)), sizeof(V), &vertex_input_state<V>());
+            m_bounds = compute_bounds(std::span<const V>(vertices));
+            m_decodePosition = position_decoder<V>();
+        }
+        // 32-bit indices are stored and drawn as 16-bit when every index fits
         void set_indices(std::span<const uint32_t> indices);
+        void set_indices(std::span<const uint16_t> indices);
 
-        // Upload data to GPU (call after setting vertices/indices)
+        // Upload data to GPU (call after setting vertices/indices). With an upload
+        // queue the copy is deferred until the queue is recorded or flushed.
+        // Existing GPU storage is reused when the data still fits.
         void upload();
 
+        // Run the optimizer over the CPU-side mesh (triangle lists only), then upload().
+        // Non-indexed meshes gain an index buffer; vertex order and count may change.
+        // Overdraw is only optimised for layouts with a position decoder.
+        MeshOptimizerReport upload(const MeshOptimizer& optimizer);
+
+        // Reserve GPU storage (in elements) so later updates can grow in place
+        void reserve(uint32_t vertexCapacity, uint32_t indexCapacity = 0);
+
+        // Overwrite (or append past the end of) part of an uploaded mesh and upload
+        // only the changed range. Storage grows geometrically when capacity is exceeded.
+        template<std::ranges::contiguous_range R>
+            requires HasVertexLayout<std::ranges::range_value_t<R>>
+        void update_vertices(uint32_t offset, const R& vertices) {
+            using V = std::ranges::range_value_t<R>;
+            update_vertex_data(offset, std::as_bytes(std::span<const V>(vertices)), sizeof(V));
+            m_bounds.expand(compute_bounds(std::span<const V>(vertices)));
+        }
+        // Indices are widened to 32-bit (re-uploading the whole index buffer) if an
+        // update no longer fits in 16 bits
+        void update_indices(uint32_t offset, std::span<const uint32_t> indices);
+        void update_indices(uint32_t offset, std::span<const uint16_t> indices);
+
+        // Shrink the drawn vertex/index counts without touching GPU data
+        void truncate(uint32_t vertexCount, uint32_t indexCount);
+
         // Render the model (shader must already be bound with uniforms set)
         void render(SDL_GPURenderPass* renderPass) const;
 
+        // Draw instanceCount instances in one call. firstInstance offsets instance-rate
+        // vertex attributes only; SV_InstanceID always starts at 0, so it must be 0
+        // for shaders that index storage buffers with it.
+        void render_instanced(SDL_GPURenderPass* renderPass, uint32_t instanceCount, uint32_t firstInstance = 0) const;
+
+        // Bind the instance buffer (slot 1 vertex buffer, or vertex storage buffer
+        // slot 0) and draw all of its instances in one call
+        void render_instanced(SDL_GPURenderPass* renderPass, const InstanceBufferBase& instances) const;
+
         // Check if model is ready to render
         [[nodiscard]] bool is_ready() const noexcept;
 
         // Accessors
         [[nodiscard]] uint32_t get_vertex_count() const noexcept { return m_vertexCount; }
+        [[nodiscard]] uint32_t get_vertex_stride() const noexcept { return m_vertexStride; }
+        [[nodiscard]] const SDL_GPUVertexInputState& get_vertex_input_state() const noexcept { return *m_vertexInputState; }
         [[nodiscard]] uint32_t get_index_count() const noexcept { return m_indexCount; }
         [[nodiscard]] bool uses_index_buffer() const noexcept { return m_useIndexBuffer; }
+        [[nodiscard]] uint32_t get_vertex_capacity() const noexcept { return m_vertexCapacity; }
+        [[nodiscard]] uint32_t get_index_capacity() const noexcept { return m_indexCapacity; }
+        [[nodiscard]] uint32_t get_index_element_size() const noexcept { return m_indexSize; }
+        [[nodiscard]] uint64_t get_index_bytes_saved() const noexcept { return m_indexBytesSaved; }
+        [[nodiscard]] uint64_t get_uploaded_bytes() const noexcept { return m_uploadedBytes; }
+        [[nodiscard]] ModelDrawInfo get_draw_info() const;
+
+        // Object-space bounds of all vertices set so far (conservative after truncate()).
+        // Layouts without a position decoder report Aabb::everything().
+        [[nodiscard]] const Aabb& get_bounds() const noexcept { return m_bounds; }
 
     private:
-        void upload_vertex_data();
-        void upload_index_data();
+        template<typename V>
+        static Aabb compute_bounds(std::span<const V> vertices) {
+            if constexpr (HasVertexPosition<V>) {
+                Aabb bounds;
+                for (const V& vertex : vertices) {
+                    std::array<float, 3> position = VertexLayout<V>::position(vertex);
+                    bounds.expand(glm::vec3{position[0], position[1], position[2]});
+                }
+                return bounds;
+            } else {
+                return Aabb::everything();
+            }
+        }
+
+        // Decodes the position of one vertex in m_vertexData
+        using PositionDecoder = std::array<float, 3> (*)(const std::byte* vertex);
+
+        template<typename V>
+        static PositionDecoder position_decoder() {
+            if constexpr (HasVertexPosition<V>) {
+                return [](const std::byte* vertex) {
+                    // Vertex data is not necessarily aligned for V
+                    std::array<std::byte, sizeof(V)> bytes;
+                    std::copy_n(vertex, sizeof(V), bytes.begin());
+                    return std::array<float, 3>(VertexLayout<V>::position(std::bit_cast<V>(bytes)));
+                };
+            } else {
+                return nullptr;
+            }
+        }
+
+        void set_vertex_data(std::span<const std::byte> data, uint32_t stride, const SDL_GPUVertexInputState* inputState);
+        void update_vertex_data(uint32_t offset, std::span<const std::byte> data, uint32_t stride);
+        void set_index_data(std::span<const std::byte> data, uint32_t indexSize);
+        void update_index_data(uint32_t offset, std::span<const std::byte> data);
+        void widen_indices();
+        void set_index_size(uint32_t indexSize);
+
+        template<typename Fn>
+        void with_upload_queue(Fn&& fn);
+
+        void upload_vertex_data(UploadQueue& queue);
+        void upload_index_data(UploadQueue& queue);
+        bool ensure_vertex_storage(uint32_t vertexCount);
+        bool ensure_index_storage(uint32_t indexCount);
+        void write_vertices(UploadQueue& queue, uint32_t first, uint32_t count, bool wholeBuffer);
+        void write_indices(UploadQueue& queue, uint32_t first, uint32_t count, bool wholeBuffer);
+        [[nodiscard]] ArenaRegion get_vertex_region() const;
+        [[nodiscard]] ArenaRegion get_index_region() const;
+
+        ArenaAllocation allocate_from_arena(uint32_t size, uint32_t alignment);
 
         SDL_GPUDevice* m_device;        // Non-owning
+        UploadQueue* m_uploadQueue;     // Non-owning, may be null
+        GpuBufferArena* m_arena;        // Non-owning, may be null
 
-        std::vector<Vertex> m_vertices;
-        std::vector<uint32_t> m_indices;
+        std::vector<std::byte> m_vertexData;
+        uint32_t m_vertexStride = sizeof(Vertex);
+        const SDL_GPUVertexInputState* m_vertexInputState = &vertex_input_state<Vertex>();
+        Aabb m_bounds;
+        PositionDecoder m_decodePosition = position_decoder<Vertex>();  // Null without a position decoder
+        std::vector<std::byte> m_indexData;
+        uint32_t m_indexSize = sizeof(uint32_t);   // 2 or 4 bytes per index; only committed while m_indexCount > 0
 
         GPUBufferPtr m_vertexBuffer;
         GPUBufferPtr m_indexBuffer;
+        ArenaAllocation m_vertexAllocation;
+        ArenaAllocation m_indexAllocation;
 
         bool m_useIndexBuffer = false;
         bool m_uploaded = false;
+        uint64_t m_uploadTicket = 0;
         uint32_t m_vertexCount = 0;
         uint32_t m_indexCount = 0;
+        uint32_t m_vertexCapacity = 0;
+        uint32_t m_indexCapacity = 0;
+        uint32_t m_reservedVertices = 0;
+        uint32_t m_reservedIndices = 0;
+        uint64_t m_uploadedBytes = 0;
+        uint64_t m_indexBytesSaved = 0;     // Upload bytes avoided by 16-bit indices
     };
 
 } // namespace minecart::graphics
\ No newline at end of file
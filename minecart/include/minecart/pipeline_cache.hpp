@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include <cstdint>
+
+namespace minecart::graphics {
+
+    // Exception class for pipeline cache errors
+    class PipelineCacheException : public std::runtime_error {
+    public:
+        explicit PipelineCacheException(const std::string& message)
+            : std::runtime_error("Pipeline cache error: " + message) {}
+    };
+
+    // Custom deleter for SDL GPU graphics pipelines
+    struct SDLGPUGraphicsPipelineDeleter {
+        SDL_GPUDevice* device = nullptr;
+        void operator()(SDL_GPUGraphicsPipeline* pipeline) const noexcept {
+            if (pipeline && device) {
+                SDL_ReleaseGPUGraphicsPipeline(device, pipeline);
+            }
+        }
+    };
+
+    // Type alias for managed pipeline
+    using GPUGraphicsPipelinePtr = std::unique_ptr<SDL_GPUGraphicsPipeline, SDLGPUGraphicsPipelineDeleter>;
+
+    struct PipelineCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;                // Pipelines created
+        uint64_t creationTimeNS = 0;        // Total time in SDL_CreateGPUGraphicsPipeline
+        uint64_t maxCreationTimeNS = 0;     // Slowest single creation (the worst hitch)
+        size_t pipelines = 0;
+
+        [[nodiscard]] double hit_rate() const noexcept {
+            uint64_t lookups = hits + misses;
+            return lookups ? static_cast<double>(hits) / static_cast<double>(lookups) : 0.0;
+        }
+    };
+
+    // Deduplicates graphics pipelines by the state they are created from: shaders,
+    // vertex input, primitive type, rasterizer, multisample, depth-stencil, blend
+    // state and target formats. Identical create infos share one pipeline, owned by
+    // the cache and released with it.
+    //
+    // Shaders are keyed by pointer: clear() the cache before destroying shaders it
+    // has seen, or a new shader at the same address could match a stale pipeline.
+    // Properties (props) are keyed by ID, not content.
+    //
+    // Create and use the cache on the main thread. Creating pipelines mid-frame
+    // stalls; prewarm() the known states during on_init instead.
+    class PipelineCache {
+    public:
+        explicit PipelineCache(SDL_GPUDevice* device);
+
+        // Prevent copying
+        PipelineCache(const PipelineCache&) = delete;
+        PipelineCache& operator=(const PipelineCache&) = delete;
+
+        // Allow moving
+        PipelineCache(PipelineCache&&) noexcept = default;
+        PipelineCache& operator=(PipelineCache&&) noexcept = default;
+
+        // The pipeline for info, creating it on first use
+        [[nodiscard]] SDL_GPUGraphicsPipeline* get(const SDL_GPUGraphicsPipelineCreateInfo& info);
+
+        // Create every state not already cached and log how long it took
+        void prewarm(const std::vector<SDL_GPUGraphicsPipelineCreateInfo>& states);
+
+        // FNV-1a hash of everything in info that affects the pipeline
+        [[nodiscard]] static uint64_t compute_hash(const SDL_GPUGraphicsPipelineCreateInfo& info);
+
+        // Release every pipeline
+        void clear();
+
+        // Log hit rate and creation times
+        void log_stats() const;
+
+        // Accessors
+        [[nodiscard]] PipelineCacheStats get_stats() const noexcept;
+        [[nodiscard]] size_t get_pipeline_count() const noexcept { return m_pipelineCount; }
+
+    private:
+        struct Entry {
+            std::vector<uint8_t> key;   // Serialised state, to rule out hash collisions
+            GPUGraphicsPipelinePtr pipeline;
+        };
+
+        SDL_GPUGraphicsPipeline* create(const SDL_GPUGraphicsPipelineCreateInfo& info, uint64_t hash);
+
+        SDL_GPUDevice* m_device;    // Non-owning
+        std::unordered_map<uint64_t, std::vector<Entry>> m_entries;
+        std::vector<uint8_t> m_scratch; // Reused for lookups so hits don't allocate
+        size_t m_pipelineCount = 0;
+
+        uint64_t m_hits = 0;
+        uint64_t m_misses = 0;
+        uint64_t m_creationTimeNS = 0;
+        uint64_t m_maxCreationTimeNS = 0;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+
+namespace minecart {
+
+    // Exception class for profiler errors
+    class ProfilerException : public std::runtime_error {
+    public:
+        explicit ProfilerException(const std::string& message)
+            : std::runtime_error("Profiler error: " + message) {}
+    };
+
+    // One finished zone. Names are not copied: pass string literals (or __func__)
+    struct ProfileEvent {
+        const char* name = nullptr;
+        uint64_t start = 0;         // SDL_GetTicksNS()
+        uint64_t end = 0;
+        uint32_t depth = 0;         // Nesting level on its thread, 0 = outermost
+    };
+
+    // Zones recorded by one thread. Only the owning thread writes; any thread may
+    // take a snapshot without blocking it. Once the ring wraps, the oldest zones
+    // are overwritten. When the thread exits its profile is retired, keeping its
+    // zones for capture until a new thread takes the profile over.
+    class ThreadProfile {
+    public:
+        static constexpr uint32_t CAPACITY = 16384;     // Power of two
+
+        ThreadProfile(uint32_t id, std::string name) : m_id(id), m_name(std::move(name)) {}
+
+        // Prevent copying and moving (threads hold a pointer to their profile)
+        ThreadProfile(const ThreadProfile&) = delete;
+        ThreadProfile& operator=(const ThreadProfile&) = delete;
+
+        // Owning thread only
+        void record(const char* name, uint64_t start, uint64_t end, uint32_t depth) noexcept;
+
+        // Zones still in the ring that ended at or after since, oldest first
+        [[nodiscard]] std::vector<ProfileEvent> snapshot(uint64_t since = 0) const;
+
+        [[nodiscard]] uint32_t get_id() const noexcept { return m_id; }
+
+    private:
+        friend class Profiler;
+        friend class ProfileScope;
+
+        // Fields are relaxed atomics so a snapshot racing the writer is well defined;
+        // torn entries are detected through m_head and dropped
+        struct Slot {
+            std::atomic<const char*> name{nullptr};
+            std::atomic<uint64_t> start{0};
+            std::atomic<uint64_t> end{0};
+            std::atomic<uint32_t> depth{0};
+        };
+
+        std::array<Slot, CAPACITY> m_slots;
+        std::atomic<uint64_t> m_head{0};    // Number of zones ever recorded
+        uint32_t m_depth = 0;               // Open scopes, owning thread only
+        uint32_t m_id;                      // Guarded by Profiler::m_mutex
+        std::string m_name;                 // Guarded by Profiler::m_mutex
+        uint64_t m_retiredAt = 0;           // When the thread exited, 0 while alive; guarded by Profiler::m_mutex
+    };
+
+    // Everything recorded between two points in time, grouped by thread
+    struct ProfileCapture {
+        struct Thread {
+            uint32_t id = 0;
+            std::string name;
+            std::vector<ProfileEvent> events;
+        };
+
+        uint64_t start = 0;
+        uint64_t end = 0;
+        std::vector<Thread> threads;
+    };
+
+    // Process-wide CPU profiler. Code is instrumented with the MINECART_PROFILE_*
+    // macros below, which compile to nothing unless MINECART_PROFILER is defined
+    // (scons profile=1). Each thread records into its own ring, so recording
+    // never takes a lock; only a thread's first zone registers it.
+    class Profiler {
+    public:
+        static constexpr uint32_t FRAME_HISTORY = 256;
+        static constexpr uint32_t MAX_RETIRED_THREADS = 8;  // Exited threads kept beyond the frame history
+
+        [[nodiscard]] static Profiler& get();
+
+        // Prevent copying and moving
+        Profiler(const Profiler&) = delete;
+        Profiler& operator=(const Profiler&) = delete;
+
+        // Mark the start of a frame (main loop only)
+        void new_frame() noexcept;
+
+        // Name the calling thread in the panel and in exported traces
+        void set_thread_name(const std::string& name);
+
+        // The calling thread's profile, registering it on first use
+        [[nodiscard]] ThreadProfile& get_thread_profile();
+
+        // Zones of every thread that ended within [start, end]
+        [[nodiscard]] ProfileCapture capture(uint64_t start, uint64_t end) const;
+
+        // Write everything still recorded as Chrome trace_event JSON, viewable in
+        // chrome://tracing or Perfetto
+        void write_chrome_trace(const std::string& path) const;
+
+        // Draw the timeline panel into the current ImGui frame (when visible)
+        void draw_panel();
+
+        // Accessors
+        [[nodiscard]] bool is_enabled() const noexcept { return m_enabled.load(std::memory_order_relaxed); }
+        [[nodiscard]] bool is_panel_visible() const noexcept { return m_panelVisible; }
+        [[nodiscard]] uint64_t get_frame_count() const noexcept { return m_frameCount.load(std::memory_order_acquire); }
+
+        // Start of a recent frame; 0 is the frame in progress, 1 the last complete one
+        [[nodiscard]] uint64_t get_frame_start(uint32_t framesAgo) const noexcept;
+
+        // Modifiers
+        void set_enabled(bool enabled) noexcept { m_enabled.store(enabled, std::memory_order_relaxed); }
+        void set_panel_visible(bool visible) noexcept { m_panelVisible = visible; }
+
+    private:
+        friend struct ThreadProfileOwner;
+
+        Profiler() = default;
+
+        // Called when a registered thread exits
+        void retire_thread_profile(ThreadProfile& profile) noexcept;
+
+        // A retired profile that may be handed to a new thread, or null; m_mutex must be held
+        [[nodiscard]] ThreadProfile* take_retired_profile() noexcept;
+
+        void draw_timeline(const ProfileCapture& frame);
+        void draw_zone_table(const ProfileCapture& frame);
+
+        std::atomic<bool> m_enabled{true};
+
+        mutable std::mutex m_mutex;         // Guards thread registration and names
+        std::vector<std::unique_ptr<ThreadProfile>> m_threads;
+        uint32_t m_nextThreadId = 0;
+
+        std::array<std::atomic<uint64_t>, FRAME_HISTORY> m_frameStarts{};
+        std::atomic<uint64_t> m_frameCount{0};
+
+        // Panel state (main thread only)
+        bool m_panelVisible = false;
+        bool m_paused = false;
+        ProfileCapture m_shownFrame;
+    };
+
+    // Records the enclosing scope as one zone of the calling thread
+    class ProfileScope {
+    public:
+        explicit ProfileScope(const char* name) noexcept;
+        ~ProfileScope();
+
+        // Prevent copying and moving
+        ProfileScope(const ProfileScope&) = delete;
+        ProfileScope& operator=(const ProfileScope&) = delete;
+
+    private:
+        ThreadProfile* m_profile = nullptr;     // Null while the profiler is disabled
+        const char* m_name;
+        uint64_t m_start = 0;
+    };
+
+} // namespace minecart
+
+#ifdef MINECART_PROFILER
+    #define MINECART_PROFILE_CONCAT_INNER(a, b) a##b
+    #define MINECART_PROFILE_CONCAT(a, b) MINECART_PROFILE_CONCAT_INNER(a, b)
+
+    #define MINECART_PROFILE_SCOPE(name) ::minecart::ProfileScope MINECART_PROFILE_CONCAT(profileScope_, __LINE__)(name)
+    #define MINECART_PROFILE_FUNCTION() MINECART_PROFILE_SCOPE(__func__)
+    #define MINECART_PROFILE_FRAME() ::minecart::Profiler::get().new_frame()
+    #define MINECART_PROFILE_THREAD(name) ::minecart::Profiler::get().set_thread_name(name)
+#else
+    #define MINECART_PROFILE_SCOPE(name) ((void)0)
+    #define MINECART_PROFILE_FUNCTION() ((void)0)
+    #define MINECART_PROFILE_FRAME() ((void)0)
+    #define MINECART_PROFILE_THREAD(name) ((void)0)
+#endif
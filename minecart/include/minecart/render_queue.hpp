@@ -0,0 +1,124 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <functional>
+#include <unordered_map>
+
+#include "minecart/model.hpp"
+
+namespace minecart::graphics {
+
+    // Order in which items of one pass are drawn
+    enum class DepthOrder {
+        FrontToBack,    // Opaque geometry: maximise early depth rejection
+        BackToFront     // Blended geometry: correct compositing
+    };
+
+    // One draw submitted to the render queue
+    struct RenderCommand {
+        uint32_t pass = 0;                              // Drawn in ascending order (0-15)
+        SDL_GPUGraphicsPipeline* pipeline = nullptr;
+        const Model* model = nullptr;
+        uint32_t material = 0;                          // Caller-defined id passed to the material binder
+        float depth = 0.0f;                             // View-space distance, used within a pass
+        uint32_t instanceCount = 1;
+        uint32_t firstInstance = 0;                     // Offsets instance-rate attributes (e.g. a FrameUniformArena index)
+        std::span<const std::byte> vertexUniforms;      // Pushed to vertex uniform slot 0 (copied on submit)
+        std::span<const std::byte> fragmentUniforms;    // Pushed to fragment uniform slot 0 (copied on submit)
+    };
+
+    // Counters for the last execute()
+    struct RenderQueueStats {
+        uint32_t items = 0;
+        uint32_t drawCalls = 0;
+        uint32_t bindsIssued = 0;       // Pipeline, buffer, material and uniform changes sent to SDL
+        uint32_t bindsSkipped = 0;      // Changes avoided because the state was already current
+    };
+
+    // Collects draws for a frame, sorts them by a 64-bit key and executes them
+    // while skipping binds that would not change GPU state.
+    //
+    // Key layout (most significant first):
+    //   pass:4 | pipeline:12 | material:12 | vertex buffer:12 | depth:24
+    //
+    // Pipelines and buffers are mapped to small ids in order of first use each
+    // frame, so items sharing state end up adjacent after sorting.
+    class RenderQueue {
+    public:
+        using MaterialBinder = std::function<void(SDL_GPUCommandBuffer*, SDL_GPURenderPass*, uint32_t material)>;
+
+        static constexpr uint32_t MAX_PASSES = 16;
+
+        RenderQueue() = default;
+        ~RenderQueue() = default;
+
+        // Prevent copying
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+
+        // Allow moving
+        RenderQueue(RenderQueue&&) noexcept = default;
+        RenderQueue& operator=(RenderQueue&&) noexcept = default;
+
+        // Called whenever the material changes between consecutive draws
+        void set_material_binder(MaterialBinder binder) { m_materialBinder = std::move(binder); }
+
+        // Depth ordering within a pass (front to back by default)
+        void set_depth_order(uint32_t pass, DepthOrder order);
+
+        // Queue a draw for this frame (models that are not ready are skipped)
+        void submit(const RenderCommand& command);
+
+        // Sort and draw everything submitted, then clear the queue for the next frame
+        void execute(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass);
+
+        // Drop submitted items without drawing them
+        void clear();
+
+        // Build a sort key from its fields (exposed for callers that pre-sort their own items)
+        [[nodiscard]] static uint64_t make_sort_key(uint32_t pass, uint32_t pipeline, uint32_t material,
+                                                    uint32_t buffer, float depth, DepthOrder order) noexcept;
+
+        // Accessors
+        [[nodiscard]] size_t size() const noexcept { return m_items.size(); }
+        [[nodiscard]] const RenderQueueStats& get_stats() const noexcept { return m_stats; }
+
+    private:
+        struct Item {
+            SDL_GPUGraphicsPipeline* pipeline;
+            ModelDrawInfo draw;
+            uint32_t material;
+            uint32_t instanceCount;
+            uint32_t firstInstance;
+            uint32_t vertexUniformOffset;
+            uint32_t vertexUniformSize;
+            uint32_t fragmentUniformOffset;
+            uint32_t fragmentUniformSize;
+        };
+
+        uint32_t intern(std::unordered_map<const void*, uint32_t>& ids, const void* object);
+        uint32_t store_uniforms(std::span<const std::byte> data);
+        void sort();
+
+        std::vector<Item> m_items;
+        std::vector<uint64_t> m_keys;
+        std::vector<uint32_t> m_order;          // Item indices in key order
+        std::vector<uint64_t> m_scratchKeys;
+        std::vector<uint32_t> m_scratchOrder;
+        std::vector<std::byte> m_uniformData;   // Per-frame copies of submitted uniforms
+
+        std::unordered_map<const void*, uint32_t> m_pipelineIds;
+        std::unordered_map<const void*, uint32_t> m_bufferIds;
+        std::array<DepthOrder, MAX_PASSES> m_depthOrder{};
+
+        MaterialBinder m_materialBinder;
+        RenderQueueStats m_stats;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <cstddef>
+#include <cstdint>
+
+#include "glm/glm.hpp"
+
+#include "minecart/camera.hpp"
+#include "minecart/culling.hpp"
+
+namespace minecart::graphics {
+
+    // Closest object hit by SceneIndex::raycast()
+    struct SceneRayHit {
+        uint32_t object = 0;
+        float distance = 0.0f;  // Along the ray to the object's bounding box
+    };
+
+    // Counters describing the current tree and the cost of its last maintenance
+    struct SceneIndexStats {
+        uint32_t objects = 0;           // Live objects
+        uint32_t nodes = 0;
+        uint32_t depth = 0;
+        float sahCost = 0.0f;           // Surface area heuristic cost of the tree (lower is better)
+        float builtSahCost = 0.0f;      // SAH cost right after the last build()
+        uint64_t builds = 0;
+        uint64_t refits = 0;
+        double lastBuildMs = 0.0;
+        double lastRefitMs = 0.0;
+    };
+
+    // Transform an object-space box by a model matrix (result bounds the transformed box)
+    [[nodiscard]] Aabb transform_bounds(const Aabb& box, const glm::mat4& transform);
+
+    // Bounding volume hierarchy over object AABBs for culling and spatial queries.
+    //
+    // Objects are inserted with world-space bounds (see transform_bounds() and
+    // Model::get_bounds()). Changes are applied by commit(): inserts and removals
+    // trigger a binned SAH rebuild, while moves only refit node bounds bottom-up.
+    // Refitting lets the tree degrade as objects move apart, so commit() rebuilds
+    // once the SAH cost exceeds the freshly built cost by the rebuild threshold.
+    // Queries see the tree as of the last commit().
+    class SceneIndex {
+    public:
+        static constexpr uint32_t INVALID_OBJECT = ~0u;
+        static constexpr uint32_t MAX_LEAF_OBJECTS = 4;
+
+        SceneIndex() = default;
+        ~SceneIndex() = default;
+
+        // Prevent copying
+        SceneIndex(const SceneIndex&) = delete;
+        SceneIndex& operator=(const SceneIndex&) = delete;
+
+        // Allow moving
+        SceneIndex(SceneIndex&&) noexcept = default;
+        SceneIndex& operator=(SceneIndex&&) noexcept = default;
+
+        // Object management; ids are reused after remove()
+        uint32_t insert(const Aabb& bounds);
+        void update(uint32_t object, const Aabb& bounds);
+        void remove(uint32_t object);
+        void clear();
+
+        // Apply pending changes (rebuild or refit as needed)
+        void commit();
+
+        // Force a full SAH rebuild / a bounds-only refit
+        void build();
+        void refit();
+
+        // Rebuild on commit() once sahCost > builtSahCost * threshold (default 1.5)
+        void set_rebuild_threshold(float threshold) noexcept { m_rebuildThreshold = threshold; }
+
+        // Queries append matching object ids to out (cleared first). Call
+        // Camera::update() before querying one camera from several threads.
+        void query_frustum(const Frustum& frustum, std::vector<uint32_t>& out) const;
+        void query_frustum(const Camera& camera, std::vector<uint32_t>& out) const { query_frustum(camera.get_frustum(), out); }
+        void query_radius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const;
+        void query_ray(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<uint32_t>& out) const;
+
+        // Closest object whose bounds the ray enters within maxDistance
+        [[nodiscard]] std::optional<SceneRayHit> raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const;
+
+        // Accessors
+        [[nodiscard]] const Aabb& get_bounds(uint32_t object) const { return m_objects[object].bounds; }
+        [[nodiscard]] bool is_dirty() const noexcept { return m_structureDirty || m_boundsDirty; }
+        [[nodiscard]] SceneIndexStats get_stats() const noexcept;
+
+    private:
+        struct Object {
+            Aabb bounds;
+            bool live = false;
+        };
+
+        // Interior nodes have count == 0 and children at first and first + 1;
+        // leaves reference count entries of m_leafObjects starting at first
+        struct Node {
+            Aabb bounds;
+            uint32_t first = 0;
+            uint32_t count = 0;
+        };
+
+        // Binned SAH split of a leaf; returns false when it should stay a leaf
+        bool split_node(uint32_t nodeIndex, const std::vector<glm::vec3>& centroids);
+        [[nodiscard]] float compute_sah_cost() const;
+
+        std::vector<Object> m_objects;
+        std::vector<uint32_t> m_freeObjects;
+        std::vector<Node> m_nodes;
+        std::vector<uint32_t> m_leafObjects;
+
+        bool m_structureDirty = false;
+        bool m_boundsDirty = false;
+        float m_rebuildThreshold = 1.5f;
+
+        uint32_t m_liveObjects = 0;
+        uint32_t m_depth = 0;
+        float m_sahCost = 0.0f;
+        float m_builtSahCost = 0.0f;
+        uint64_t m_builds = 0;
+        uint64_t m_refits = 0;
+        double m_lastBuildMs = 0.0;
+        double m_lastRefitMs = 0.0;
+    };
+
+} // namespace minecart::graphics
@@ -5,10 +5,13 @@
 #include <memory>
 #include <string>
 #include <span>
+#include <vector>
 #include <stdexcept>
 #include <cstdint>
 #include <filesystem>
 
+#include "minecart/gpu_stats.hpp"
+
 namespace minecart::graphics {
 
     // Exception class for shader-related errors
@@ -23,6 +26,7 @@ namespace minecart::graphics {
         SDL_GPUDevice* device = nullptr;
         void operator()(SDL_GPUShader* shader) const noexcept {
             if (shader && device) {
+                GpuStats::get().untrack_shader(shader);
                 SDL_ReleaseGPUShader(device, shader);
             }
         }
@@ -31,10 +35,57 @@ namespace minecart::graphics {
     // Type aliases for managed resources
     using GPUShaderPtr = std::unique_ptr<SDL_GPUShader, SDLGPUShaderDeleter>;
 
+    class ShaderCache;
+
+    // Preprocessor define passed to the HLSL compiler
+    struct ShaderDefine {
+        std::string name;
+        std::string value;
+    };
+
+    // One shader stage's HLSL source and how to compile it
+    struct ShaderSourceDesc {
+        std::filesystem::path path;
+        std::string entrypoint = "main";
+        SDL_GPUShaderStage stage = SDL_GPU_SHADERSTAGE_VERTEX;
+        std::vector<ShaderDefine> defines;
+    };
+
+    // Resource counts reflected from SPIR-V, as SDL_CreateGPUShader needs them
+    struct ShaderResourceInfo {
+        uint32_t numSamplers = 0;
+        uint32_t numStorageTextures = 0;
+        uint32_t numStorageBuffers = 0;
+        uint32_t numUniformBuffers = 0;
+    };
+
+    // SPIR-V and reflection results, ready for GPU shader creation
+    struct CompiledShader {
+        std::vector<uint8_t> spirv;
+        ShaderResourceInfo resources;
+        std::string entrypoint;
+        SDL_GPUShaderStage stage = SDL_GPU_SHADERSTAGE_VERTEX;
+        bool fromCache = false;
+        uint64_t timeNS = 0;        // Spent compiling, or loading from the cache
+    };
+
+    // Initialise SDL_shadercross once per process (later calls return immediately)
+    void initialize_shadercross();
+
+    // Compile HLSL to SPIR-V and reflect it, through cache when given. Safe to call
+    // from any thread once SDL_shadercross is initialised.
+    [[nodiscard]] CompiledShader compile_shader(const ShaderSourceDesc& desc, ShaderCache* cache = nullptr);
+
+    // Create the GPU shader on the device thread. SPIR-V goes straight to
+    // SDL_CreateGPUShader when the device accepts it, otherwise SDL_shadercross
+    // translates it for the backend.
+    [[nodiscard]] GPUShaderPtr create_gpu_shader(SDL_GPUDevice* device, const CompiledShader& shader);
+
     class Shader {
     public:
-        // Constructor - takes non-owning pointers to device and window
-        Shader(SDL_GPUDevice* device, SDL_Window* window);
+        // Constructor - takes non-owning pointers to device, window and (optionally)
+        // the cache that compiled SPIR-V is read from and written to
+        Shader(SDL_GPUDevice* device, SDL_Window* window, ShaderCache* cache = nullptr);
         ~Shader() = default;
 
         // Prevent copying
@@ -46,8 +97,8 @@ namespace minecart::graphics {
         Shader& operator=(Shader&&) noexcept = default;
 
         // Load shaders from HLSL source files (compiled at runtime via SDL_shadercross)
-        void load_vertex_shader(const std::filesystem::path& path, const char* entrypoint = "main");
-        void load_fragment_shader(const std::filesystem::path& path, const char* entrypoint = "main");
+        void load_vertex_shader(const std::filesystem::path& path, const char* entrypoint = "main", const std::vector<ShaderDefine>& defines = {});
+        void load_fragment_shader(const std::filesystem::path& path, const char* entrypoint = "main", const std::vector<ShaderDefine>& defines = {});
 
         // Get the shaders (for pipeline creation elsewhere)
         [[nodiscard]] SDL_GPUShader* get_vertex_shader() const noexcept { return m_vertexShader.get(); }
@@ -56,7 +107,8 @@ namespace minecart::graphics {
         // Bind the pipeline for rendering (call before setting uniforms and drawing)
         void bind(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass, SDL_GPUGraphicsPipeline* pipeline);
 
-        // Set uniform data for vertex shader at specified slot (0-3)
+        // Set uniform data for vertex shader at specified slot (0-3). Suits per-frame or
+        // per-pass data; put per-object data in a FrameUniformArena instead
         template<typename T>
         void set_vertex_uniform(SDL_GPUCommandBuffer* commandBuffer, uint32_t slot, const T& data) {
             set_vertex_uniform_raw(commandBuffer, slot, &data, sizeof(T));
@@ -72,8 +124,12 @@ namespace minecart::graphics {
         void set_vertex_uniform_raw(SDL_GPUCommandBuffer* commandBuffer, uint32_t slot, const void* data, uint32_t size);
         void set_fragment_uniform_raw(SDL_GPUCommandBuffer* commandBuffer, uint32_t slot, const void* data, uint32_t size);
 
+        void load_shader(const std::filesystem::path& path, const char* entrypoint, SDL_GPUShaderStage stage,
+                         const std::vector<ShaderDefine>& defines, GPUShaderPtr& target);
+
         SDL_GPUDevice* m_device;    // Non-owning
         SDL_Window* m_window;       // Non-owning
+        ShaderCache* m_cache;       // Non-owning, may be null
 
         GPUShaderPtr m_vertexShader;
         GPUShaderPtr m_fragmentShader;
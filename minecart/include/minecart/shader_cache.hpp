@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <filesystem>
+#include <cstdint>
+
+#include "minecart/shader.hpp"
+
+namespace minecart::graphics {
+
+    // Exception class for shader cache errors
+    class ShaderCacheException : public std::runtime_error {
+    public:
+        explicit ShaderCacheException(const std::string& message)
+            : std::runtime_error("Shader cache error: " + message) {}
+    };
+
+    struct ShaderCacheStats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t rejected = 0;      // Entries that failed validation (counted as misses too)
+        uint64_t hitTimeNS = 0;     // Total time loading hits
+        uint64_t missTimeNS = 0;    // Total time compiling misses
+    };
+
+    // Content-addressed store of compiled SPIR-V and its reflected resource counts,
+    // so later launches skip HLSL compilation and reflection. Entries are keyed by a
+    // hash of everything that affects the output: source, included files, entry
+    // point, stage, defines and the SDL_shadercross version. Stale entries are never
+    // read, only orphaned; clear() removes them.
+    //
+    // Safe to use from several threads at once (see ShaderLibrary): entries are
+    // written to a temporary file and renamed into place.
+    class ShaderCache {
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+        // Creates the directory if needed
+        explicit ShaderCache(std::filesystem::path directory);
+
+        // Prevent copying and moving (shaders hold a pointer to the cache)
+        ShaderCache(const ShaderCache&) = delete;
+        ShaderCache& operator=(const ShaderCache&) = delete;
+
+        // FNV-1a hash of the inputs; includes are resolved against the source's directory
+        [[nodiscard]] static uint64_t compute_key(const ShaderSourceDesc& desc, const std::string& source);
+
+        // Read and validate an entry; false on a miss or a corrupt entry
+        bool load(uint64_t key, const ShaderSourceDesc& desc, CompiledShader& out);
+
+        // Write an entry; failures are logged and otherwise ignored
+        void store(uint64_t key, const CompiledShader& shader);
+
+        // Remove every entry
+        void clear();
+
+        // Count a load or compile towards the statistics
+        void record(const CompiledShader& shader) noexcept;
+
+        // Log hits and misses with their total times (cold vs warm startup)
+        void log_stats() const;
+
+        // Accessors
+        [[nodiscard]] const std::filesystem::path& get_directory() const noexcept { return m_directory; }
+        [[nodiscard]] ShaderCacheStats get_stats() const noexcept;
+
+    private:
+        [[nodiscard]] std::filesystem::path entry_path(uint64_t key) const;
+
+        std::filesystem::path m_directory;
+
+        std::atomic<uint64_t> m_hits{0};
+        std::atomic<uint64_t> m_misses{0};
+        std::atomic<uint64_t> m_rejected{0};
+        std::atomic<uint64_t> m_hitTimeNS{0};
+        std::atomic<uint64_t> m_missTimeNS{0};
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstdint>
+
+#include "minecart/job_system.hpp"
+#include "minecart/shader.hpp"
+
+namespace minecart::graphics {
+
+    class ShaderCache;
+
+    // Exception class for shader library errors
+    class ShaderLibraryException : public std::runtime_error {
+    public:
+        explicit ShaderLibraryException(const std::string& message)
+            : std::runtime_error("Shader library error: " + message) {}
+    };
+
+    // Index of a shader in its library; stays valid for the library's lifetime
+    using ShaderHandle = uint32_t;
+
+    enum class ShaderState : uint8_t {
+        Pending,    // Compiling on a worker, or waiting for the main thread to create it
+        Ready,
+        Failed
+    };
+
+    struct ShaderManifestEntry {
+        std::string name;
+        ShaderSourceDesc source;
+    };
+
+    // Compiles shaders in the background: HLSL to SPIR-V and reflection run as jobs
+    // across the workers, then the GPU shader is created by a main-thread job
+    // (JobSystem::run_main_thread_jobs(), once per frame). Until a shader is ready,
+    // get() returns the placeholder for its stage so rendering can start at once.
+    //
+    // Create, use and destroy the library on the main thread; the destructor waits
+    // for outstanding compiles, so destroy it before the JobSystem.
+    class ShaderLibrary {
+    public:
+        ShaderLibrary(SDL_GPUDevice* device, JobSystem& jobSystem, ShaderCache* cache = nullptr);
+        ~ShaderLibrary();
+
+        // Prevent copying and moving (jobs hold a pointer to the library)
+        ShaderLibrary(const ShaderLibrary&) = delete;
+        ShaderLibrary& operator=(const ShaderLibrary&) = delete;
+        ShaderLibrary(ShaderLibrary&&) = delete;
+        ShaderLibrary& operator=(ShaderLibrary&&) = delete;
+
+        // Start compiling a shader; names must be unique
+        ShaderHandle add(const std::string& name, const ShaderSourceDesc& source);
+
+        // Start compiling every entry, returning handles in manifest order
+        std::vector<ShaderHandle> add_manifest(const std::vector<ShaderManifestEntry>& manifest);
+
+        // Compile and create the stand-in for a stage right away (keep it trivial)
+        void set_placeholder(const ShaderSourceDesc& source);
+
+        // The shader if ready, otherwise its stage's placeholder (null if none)
+        [[nodiscard]] SDL_GPUShader* get(ShaderHandle handle) const;
+
+        // Block until every shader added so far is ready or failed
+        void wait_all();
+
+        // Accessors
+        [[nodiscard]] ShaderHandle find(const std::string& name) const;
+        [[nodiscard]] ShaderState get_state(ShaderHandle handle) const;
+        [[nodiscard]] bool is_ready(ShaderHandle handle) const { return get_state(handle) == ShaderState::Ready; }
+        [[nodiscard]] const std::string& get_error(ShaderHandle handle) const;
+        [[nodiscard]] uint32_t get_pending() const noexcept { return m_counter.get_pending(); }
+        [[nodiscard]] size_t get_shader_count() const;
+
+    private:
+        struct Entry {
+            std::string name;
+            ShaderSourceDesc source;
+            std::atomic<ShaderState> state{ShaderState::Pending};
+            CompiledShader compiled;        // Handed from the worker to the main-thread job
+            GPUShaderPtr shader;
+            std::string error;              // Written before state becomes Failed
+        };
+
+        [[nodiscard]] Entry& get_entry(ShaderHandle handle) const;
+        void compile(Entry& entry);
+        void create(Entry& entry);
+        void fail(Entry& entry, const std::string& message);
+
+        SDL_GPUDevice* m_device;    // Non-owning
+        JobSystem& m_jobSystem;
+        ShaderCache* m_cache;       // Non-owning, may be null
+
+        mutable std::mutex m_mutex; // Guards the entry list, not the entries
+        std::vector<std::unique_ptr<Entry>> m_entries;
+        GPUShaderPtr m_vertexPlaceholder;
+        GPUShaderPtr m_fragmentPlaceholder;
+        JobCounter m_counter;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <unordered_map>
+#include <cstdint>
+
+#include "minecart/shader.hpp"
+#include "minecart/shader_library.hpp"
+
+namespace minecart::graphics {
+
+    class ShaderCache;
+
+    // Exception class for shader variant errors
+    class ShaderVariantException : public std::runtime_error {
+    public:
+        explicit ShaderVariantException(const std::string& message)
+            : std::runtime_error("Shader variant error: " + message) {}
+    };
+
+    // Bitmask of enabled features; bit i is the i-th feature key
+    using ShaderFeatureMask = uint32_t;
+
+    // Compile-time specialisations of one shader stage. Each feature key becomes a
+    // preprocessor define (KEY=1) when its bit is set, so disabled paths are
+    // stripped by the compiler instead of branched over at run time:
+    //
+    //     ShaderVariants chunk(device, source, {"FOG", "LIGHTING", "ALPHA_TEST"});
+    //     SDL_GPUShader* shader = chunk.get(chunk.mask_of({"FOG"}));
+    //
+    // A variant is compiled the first time it is requested. Without a library that
+    // happens on the calling thread; with one it is compiled in the background and
+    // get() returns the library's placeholder until it is ready.
+    class ShaderVariants {
+    public:
+        static constexpr uint32_t MAX_FEATURES = 32;
+
+        ShaderVariants(SDL_GPUDevice* device, ShaderSourceDesc source, std::vector<std::string> features,
+                       ShaderCache* cache = nullptr, ShaderLibrary* library = nullptr);
+
+        // Prevent copying
+        ShaderVariants(const ShaderVariants&) = delete;
+        ShaderVariants& operator=(const ShaderVariants&) = delete;
+
+        // Allow moving
+        ShaderVariants(ShaderVariants&&) noexcept = default;
+        ShaderVariants& operator=(ShaderVariants&&) noexcept = default;
+
+        // Bit of a feature key, or the mask of several
+        [[nodiscard]] ShaderFeatureMask bit_of(const std::string& feature) const;
+        [[nodiscard]] ShaderFeatureMask mask_of(const std::vector<std::string>& features) const;
+
+        // The variant for mask, compiling it on first use
+        [[nodiscard]] SDL_GPUShader* get(ShaderFeatureMask mask);
+
+        // Start compiling variants before they are needed (e.g. during on_init)
+        void prepare(ShaderFeatureMask mask);
+
+        // Defines a variant is compiled with: the source's own, then the enabled features
+        [[nodiscard]] std::vector<ShaderDefine> defines_for(ShaderFeatureMask mask) const;
+
+        // Accessors
+        [[nodiscard]] const std::vector<std::string>& get_features() const noexcept { return m_features; }
+        [[nodiscard]] size_t get_variant_count() const noexcept { return m_variants.size(); }
+        [[nodiscard]] bool has_variant(ShaderFeatureMask mask) const { return m_variants.contains(mask); }
+
+    private:
+        struct Variant {
+            GPUShaderPtr shader;        // Compiled in place
+            ShaderHandle handle = 0;    // Compiled by the library
+        };
+
+        Variant& request(ShaderFeatureMask mask);
+
+        SDL_GPUDevice* m_device;    // Non-owning
+        ShaderCache* m_cache;       // Non-owning, may be null
+        ShaderLibrary* m_library;   // Non-owning, may be null
+        ShaderSourceDesc m_source;
+        std::vector<std::string> m_features;
+        ShaderFeatureMask m_validMask;
+        std::string m_libraryName;  // <path>:<entry>:<stage>#<hash of base defines and feature keys>;
+                                    // variants are added to the library as <m_libraryName>#<mask>
+        std::unordered_map<ShaderFeatureMask, Variant> m_variants;
+    };
+
+} // namespace minecart::graphics
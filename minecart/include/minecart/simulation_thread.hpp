@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <thread>
+#include <string>
+#include <stdexcept>
+#include <functional>
+#include <cstdint>
+
+namespace minecart {
+
+    // Exception class for simulation thread errors
+    class SimulationException : public std::runtime_error {
+    public:
+        explicit SimulationException(const std::string& message)
+            : std::runtime_error("Simulation error: " + message) {}
+    };
+
+    // Runs a tick function at a fixed rate on a dedicated thread, so simulation
+    // keeps its pace while the main thread waits on the swapchain or GPU. Results
+    // reach the render thread through snapshots (see TripleBuffer).
+    //
+    // When ticks fall more than MAX_CATCH_UP_TICKS behind (a debugger pause, a
+    // long stall) the missed ticks are dropped instead of replayed back to back.
+    class SimulationThread {
+    public:
+        // Called with the fixed tick length in seconds; return false to quit
+        using TickFunction = std::function<bool(double)>;
+
+        static constexpr uint32_t MAX_CATCH_UP_TICKS = 5;
+
+        SimulationThread() = default;
+        ~SimulationThread() { stop(); }
+
+        // Prevent copying and moving (the thread holds a pointer to this object)
+        SimulationThread(const SimulationThread&) = delete;
+        SimulationThread& operator=(const SimulationThread&) = delete;
+        SimulationThread(SimulationThread&&) = delete;
+        SimulationThread& operator=(SimulationThread&&) = delete;
+
+        // Start ticking tickRate times per second (stops a running thread first)
+        void start(double tickRate, TickFunction tick);
+
+        // Stop after the current tick and join the thread
+        void stop();
+
+        // Accessors
+        [[nodiscard]] bool is_running() const noexcept { return m_thread.joinable() && !m_quit.load(std::memory_order_acquire); }
+        [[nodiscard]] bool has_quit() const noexcept { return m_quit.load(std::memory_order_acquire); }
+        [[nodiscard]] bool has_failed() const noexcept { return m_failed.load(std::memory_order_acquire); }
+        [[nodiscard]] uint64_t get_tick_count() const noexcept { return m_ticks.load(std::memory_order_relaxed); }
+        [[nodiscard]] uint64_t get_dropped_ticks() const noexcept { return m_droppedTicks.load(std::memory_order_relaxed); }
+        [[nodiscard]] double get_tick_rate() const noexcept { return m_tickRate; }
+
+        // Fraction of a tick (0-1) elapsed since the last tick was due, for
+        // interpolating between the two most recent snapshots
+        [[nodiscard]] float get_interpolation_alpha() const noexcept;
+
+    private:
+        void run();
+
+        std::thread m_thread;
+        TickFunction m_tick;
+        double m_tickRate = 60.0;
+        std::atomic<bool> m_stopping{false};
+        std::atomic<bool> m_quit{false};            // Tick function asked to quit (or threw)
+        std::atomic<bool> m_failed{false};          // Tick function threw
+        std::atomic<uint64_t> m_ticks{0};
+        std::atomic<uint64_t> m_droppedTicks{0};
+        std::atomic<uint64_t> m_lastTickNS{0};      // When the last tick was due (SDL_GetTicksNS)
+    };
+
+} // namespace minecart
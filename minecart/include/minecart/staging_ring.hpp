@@ -0,0 +1,83 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace minecart::graphics {
+
+    // Location of data written into the staging ring
+    struct StagingAllocation {
+        SDL_GPUTransferBuffer* transferBuffer = nullptr;
+        uint32_t offset = 0;
+        uint32_t size = 0;
+    };
+
+    // Counters describing staging ring pressure
+    struct StagingRingStats {
+        uint64_t allocations = 0;           // Successful writes into the ring
+        uint64_t bytesAllocated = 0;        // Bytes written into the ring (including fallbacks)
+        uint64_t wraps = 0;                 // Times the allocator moved on to the next block
+        uint64_t stalls = 0;                // Wraps onto a block already used this frame (forces a driver cycle)
+        uint64_t oversizedFallbacks = 0;    // Writes larger than a block that got a transient transfer buffer
+    };
+
+    // Frame-aware ring of persistent upload transfer buffers. Each frame starts
+    // in the next block, which is mapped with cycle=true so data still read by
+    // frames in flight is preserved. Within a block a linear allocator hands
+    // out aligned regions.
+    //
+    // Regions must be recorded into a copy pass before the next write() call,
+    // because a wrap may cycle the block they live in.
+    class StagingRing {
+    public:
+        static constexpr uint32_t DEFAULT_BLOCK_SIZE = 4 * 1024 * 1024;
+        static constexpr uint32_t DEFAULT_BLOCK_COUNT = 3;
+
+        // Constructor - takes non-owning pointer to device
+        explicit StagingRing(SDL_GPUDevice* device,
+                             uint32_t blockSize = DEFAULT_BLOCK_SIZE,
+                             uint32_t blockCount = DEFAULT_BLOCK_COUNT);
+        ~StagingRing();
+
+        // Prevent copying and moving (upload queues keep a pointer to their ring)
+        StagingRing(const StagingRing&) = delete;
+        StagingRing& operator=(const StagingRing&) = delete;
+        StagingRing(StagingRing&&) = delete;
+        StagingRing& operator=(StagingRing&&) = delete;
+
+        // Move to the next block and release transient buffers from the previous frame
+        void begin_frame();
+
+        // Copy data into the ring and return where it was placed
+        StagingAllocation write(std::span<const std::byte> data, uint32_t alignment = 16);
+
+        // Accessors
+        [[nodiscard]] uint32_t get_block_size() const noexcept { return m_blockSize; }
+        [[nodiscard]] uint32_t get_block_count() const noexcept { return static_cast<uint32_t>(m_blocks.size()); }
+        [[nodiscard]] const StagingRingStats& get_stats() const noexcept { return m_stats; }
+        void reset_stats() noexcept { m_stats = {}; }
+
+    private:
+        void advance_block();
+        StagingAllocation write_transient(std::span<const std::byte> data);
+        void release_transient() noexcept;
+
+        SDL_GPUDevice* m_device;    // Non-owning
+
+        std::vector<SDL_GPUTransferBuffer*> m_blocks;
+        std::vector<SDL_GPUTransferBuffer*> m_transient;
+        uint32_t m_blockSize;
+
+        uint32_t m_currentBlock = 0;
+        uint32_t m_head = 0;
+        uint32_t m_blocksUsedThisFrame = 1;
+        bool m_cycleOnNextMap = true;
+
+        StagingRingStats m_stats;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace minecart {
+
+    // Lock-free hand-off of the latest value from one writer thread to one reader
+    // thread. The writer fills write_buffer() and publish()es it; the reader calls
+    // update() to switch to the newest published value and reads read_buffer().
+    // Neither side ever waits, and the reader's buffer stays untouched until its
+    // next update(), which makes it suitable for immutable render snapshots.
+    template<typename T>
+    class TripleBuffer {
+    public:
+        TripleBuffer() = default;
+        explicit TripleBuffer(const T& initial) : m_buffers{initial, initial, initial} {}
+
+        // Prevent copying and moving (the buffers are shared between threads)
+        TripleBuffer(const TripleBuffer&) = delete;
+        TripleBuffer& operator=(const TripleBuffer&) = delete;
+
+        // Writer side
+        [[nodiscard]] T& write_buffer() noexcept { return m_buffers[m_writeIndex]; }
+        void publish() noexcept {
+            uint8_t previous = m_middle.exchange(static_cast<uint8_t>(m_writeIndex | FRESH), std::memory_order_acq_rel);
+            m_writeIndex = previous & INDEX_MASK;
+        }
+
+        // Reader side; returns true if a newer value was published since the last update
+        bool update() noexcept {
+            if (!(m_middle.load(std::memory_order_relaxed) & FRESH)) {
+                return false;
+            }
+            uint8_t previous = m_middle.exchange(m_readIndex, std::memory_order_acq_rel);
+            m_readIndex = previous & INDEX_MASK;
+            return true;
+        }
+        [[nodiscard]] const T& read_buffer() const noexcept { return m_buffers[m_readIndex]; }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x3;
+        static constexpr uint8_t FRESH = 0x4;   // Set while the middle buffer holds an unread value
+
+        std::array<T, 3> m_buffers{};
+
+        // Each index on its own cache line so writer and reader do not share one
+        alignas(64) std::atomic<uint8_t> m_middle{1};
+        alignas(64) uint8_t m_writeIndex = 0;
+        alignas(64) uint8_t m_readIndex = 2;
+    };
+
+} // namespace minecart
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "minecart/staging_ring.hpp"
+
+namespace minecart::graphics {
+
+    // Exception class for upload-related errors
+    class UploadException : public std::runtime_error {
+    public:
+        explicit UploadException(const std::string& message)
+            : std::runtime_error("Upload error: " + message) {}
+    };
+
+    // Counters describing how well uploads are being batched
+    struct UploadQueueStats {
+        uint64_t flushes = 0;           // Batches recorded into a copy pass
+        uint64_t uploads = 0;           // Regions uploaded over the queue's lifetime
+        uint64_t submitsSaved = 0;      // Submits avoided compared to one submit per region
+        uint64_t bytesTotal = 0;        // Bytes uploaded over the queue's lifetime
+        uint64_t lastFlushBytes = 0;    // Bytes uploaded by the most recent batch
+        uint32_t lastFlushUploads = 0;  // Regions uploaded by the most recent batch
+    };
+
+    // Collects buffer uploads and records them as a single copy pass backed by
+    // one packed staging allocation. Window drains the queue into the frame's
+    // command buffer before the render pass begins.
+    class UploadQueue {
+    public:
+        // Constructor - takes non-owning pointers to device and (optionally) a staging ring.
+        // Without a ring every batch creates and releases its own transfer buffer.
+        explicit UploadQueue(SDL_GPUDevice* device, StagingRing* stagingRing = nullptr);
+        ~UploadQueue() = default;
+
+        // Prevent copying and moving (models keep a pointer to their queue)
+        UploadQueue(const UploadQueue&) = delete;
+        UploadQueue& operator=(const UploadQueue&) = delete;
+        UploadQueue(UploadQueue&&) = delete;
+        UploadQueue& operator=(UploadQueue&&) = delete;
+
+        // Queue a copy of data into buffer at offset. The data is copied into the
+        // staging area immediately. Returns a ticket that can be passed to is_complete().
+        uint64_t enqueue(SDL_GPUBuffer* buffer, uint32_t offset, std::span<const std::byte> data, bool cycle = false);
+
+        template<typename T>
+        uint64_t enqueue(SDL_GPUBuffer* buffer, uint32_t offset, std::span<const T> data, bool cycle = false) {
+            return enqueue(buffer, offset, std::as_bytes(data), cycle);
+        }
+
+        // Drop pending uploads that target buffer (call before releasing it)
+        void discard(SDL_GPUBuffer* buffer) noexcept;
+
+        // Drop pending uploads that lie within [offset, offset + size) of buffer
+        // (call before a sub-allocation of a shared buffer is reused)
+        void discard(SDL_GPUBuffer* buffer, uint32_t offset, uint32_t size) noexcept;
+
+        // Record pending uploads into commandBuffer (must be outside of any render pass)
+        void record(SDL_GPUCommandBuffer* commandBuffer);
+
+        // Record pending uploads into a dedicated command buffer and submit it
+        void flush();
+
+        // Check whether the uploads associated with a ticket have been recorded
+        [[nodiscard]] bool is_complete(uint64_t ticket) const noexcept { return ticket <= m_recordedBatch; }
+
+        // Accessors
+        [[nodiscard]] bool empty() const noexcept { return m_pending.empty(); }
+        [[nodiscard]] size_t get_pending_bytes() const noexcept { return m_staging.size(); }
+        [[nodiscard]] const UploadQueueStats& get_stats() const noexcept { return m_stats; }
+        void reset_stats() noexcept { m_stats = {}; }
+
+    private:
+        struct PendingUpload {
+            SDL_GPUBuffer* buffer;
+            uint32_t stagingOffset;
+            uint32_t offset;
+            uint32_t size;
+            bool cycle;
+        };
+
+        void record_batch(SDL_GPUCommandBuffer* commandBuffer, bool dedicatedSubmit);
+
+        SDL_GPUDevice* m_device;        // Non-owning
+        StagingRing* m_stagingRing;     // Non-owning, may be null
+
+        std::vector<std::byte> m_staging;
+        std::vector<PendingUpload> m_pending;
+
+        uint64_t m_currentBatch = 1;
+        uint64_t m_recordedBatch = 0;
+        UploadQueueStats m_stats;
+    };
+
+} // namespace minecart::graphics
@@ -0,0 +1,328 @@
+#pragma once
+
+#include <SDL3/SDL.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <concepts>
+
+namespace minecart::graphics {
+
+    // Size in bytes of a vertex element format (0 for INVALID or unknown formats)
+    constexpr uint32_t vertex_element_size(SDL_GPUVertexElementFormat format) {
+        switch (format) {
+            case SDL_GPU_VERTEXELEMENTFORMAT_BYTE2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_BYTE2_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE2_NORM:
+                return 2;
+            case SDL_GPU_VERTEXELEMENTFORMAT_INT:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UINT:
+            case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT:
+            case SDL_GPU_VERTEXELEMENTFORMAT_BYTE4:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4:
+            case SDL_GPU_VERTEXELEMENTFORMAT_BYTE4_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_SHORT2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_USHORT2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_SHORT2_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_USHORT2_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_HALF2:
+                return 4;
+            case SDL_GPU_VERTEXELEMENTFORMAT_INT2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UINT2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT2:
+            case SDL_GPU_VERTEXELEMENTFORMAT_SHORT4:
+            case SDL_GPU_VERTEXELEMENTFORMAT_USHORT4:
+            case SDL_GPU_VERTEXELEMENTFORMAT_SHORT4_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_USHORT4_NORM:
+            case SDL_GPU_VERTEXELEMENTFORMAT_HALF4:
+                return 8;
+            case SDL_GPU_VERTEXELEMENTFORMAT_INT3:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UINT3:
+            case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3:
+                return 12;
+            case SDL_GPU_VERTEXELEMENTFORMAT_INT4:
+            case SDL_GPU_VERTEXELEMENTFORMAT_UINT4:
+            case SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4:
+                return 16;
+            default:
+                return 0;
+        }
+    }
+
+    // Describe one attribute of a vertex struct (buffer slot 0)
+    constexpr SDL_GPUVertexAttribute vertex_attribute(uint32_t location, SDL_GPUVertexElementFormat format, size_t offset) {
+        return SDL_GPUVertexAttribute{location, 0, format, static_cast<Uint32>(offset)};
+    }
+
+    // Specialise for each vertex struct with a constexpr std::array named `attributes`,
+    // and optionally a `position` decoder so models can compute bounds:
+    //
+    //     template<> struct VertexLayout<MyVertex> {
+    //         static constexpr std::array attributes{
+    //             vertex_attribute(0, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, offsetof(MyVertex, position)),
+    //         };
+    //         static constexpr std::array<float, 3> position(const MyVertex& v) { ... }
+    //     };
+    template<typename V>
+    struct VertexLayout;
+
+    template<typename V>
+    concept HasVertexLayout = requires {
+        { VertexLayout<V>::attributes.size() } -> std::convertible_to<size_t>;
+    };
+
+    template<typename V>
+    concept HasVertexPosition = HasVertexLayout<V> && requires(const V& vertex) {
+        { VertexLayout<V>::position(vertex) } -> std::convertible_to<std::array<float, 3>>;
+    };
+
+    // Compile-time check that every attribute has a sized element format
+    template<typename V>
+    constexpr bool has_known_vertex_formats() {
+        return std::all_of(VertexLayout<V>::attributes.begin(), VertexLayout<V>::attributes.end(),
+                           [](const SDL_GPUVertexAttribute& attribute) { return vertex_element_size(attribute.format) != 0; });
+    }
+
+    // Compile-time checks: known formats, attributes inside the struct, no overlaps, unique locations
+    template<typename V>
+    constexpr bool is_valid_vertex_layout() {
+        const auto& attributes = VertexLayout<V>::attributes;
+        for (size_t i = 0; i < attributes.size(); ++i) {
+            uint32_t size = vertex_element_size(attributes[i].format);
+            if (size == 0 || attributes[i].offset + size > sizeof(V)) {
+                return false;
+            }
+            for (size_t j = i + 1; j < attributes.size(); ++j) {
+                uint32_t otherSize = vertex_element_size(attributes[j].format);
+                if (attributes[i].location == attributes[j].location) {
+                    return false;
+                }
+                if (attributes[i].offset < attributes[j].offset + otherSize &&
+                    attributes[j].offset < attributes[i].offset + size) {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    // Pipeline vertex input state generated from a VertexLayout specialisation
+    template<typename V>
+        requires HasVertexLayout<V>
+    struct VertexInput {
+        static_assert(has_known_vertex_formats<V>(), "Vertex layout uses an invalid or unknown element format");
+        static_assert(!has_known_vertex_formats<V>() || is_valid_vertex_layout<V>(),
+                      "Vertex layout attributes overlap, repeat a location or overrun the struct");
+
+        static constexpr SDL_GPUVertexBufferDescription bufferDescription{
+            0, sizeof(V), SDL_GPU_VERTEXINPUTRATE_VERTEX, 0
+        };
+        static constexpr auto attributes = VertexLayout<V>::attributes;
+        static constexpr SDL_GPUVertexInputState state{
+            &bufferDescription, 1,
+            attributes.data(), static_cast<Uint32>(attributes.size())
+        };
+    };
+
+    // Vertex input state to plug into SDL_GPUGraphicsPipelineCreateInfo
+    template<typename V>
+        requires HasVertexLayout<V>
+    constexpr const SDL_GPUVertexInputState& vertex_input_state() {
+        return VertexInput<V>::state;
+    }
+
+    // Pipeline vertex input state for per-vertex data V in buffer slot 0 and
+    // per-instance data I in slot 1 (instance-rate vertex buffer). Attribute
+    // locations of V and I must not collide.
+    template<typename V, typename I>
+        requires HasVertexLayout<V> && HasVertexLayout<I>
+    struct InstancedVertexInput {
+        static_assert(has_known_vertex_formats<V>() && has_known_vertex_formats<I>(),
+                      "Vertex layout uses an invalid or unknown element format");
+        static_assert(!has_known_vertex_formats<V>() || !has_known_vertex_formats<I>() ||
+                      (is_valid_vertex_layout<V>() && is_valid_vertex_layout<I>()),
+                      "Vertex layout attributes overlap, repeat a location or overrun the struct");
+
+        static constexpr std::array<SDL_GPUVertexBufferDescription, 2> bufferDescriptions{{
+            {0, sizeof(V), SDL_GPU_VERTEXINPUTRATE_VERTEX, 0},
+            {1, sizeof(I), SDL_GPU_VERTEXINPUTRATE_INSTANCE, 0},
+        }};
+        static constexpr auto attributes = [] {
+            constexpr size_t vertexCount = VertexLayout<V>::attributes.size();
+            std::array<SDL_GPUVertexAttribute, vertexCount + VertexLayout<I>::attributes.size()> result{};
+            std::copy(VertexLayout<V>::attributes.begin(), VertexLayout<V>::attributes.end(), result.begin());
+            std::copy(VertexLayout<I>::attributes.begin(), VertexLayout<I>::attributes.end(), result.begin() + vertexCount);
+            for (size_t i = vertexCount; i < result.size(); ++i) {
+                result[i].buffer_slot = 1;
+            }
+            return result;
+        }();
+        static_assert([] {
+            for (size_t i = 0; i < attributes.size(); ++i) {
+                for (size_t j = i + 1; j < attributes.size(); ++j) {
+                    if (attributes[i].location == attributes[j].location) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }(), "Vertex and instance layouts use the same attribute location");
+
+        static constexpr SDL_GPUVertexInputState state{
+            bufferDescriptions.data(), static_cast<Uint32>(bufferDescriptions.size()),
+            attributes.data(), static_cast<Uint32>(attributes.size())
+        };
+    };
+
+    template<typename V, typename I>
+        requires HasVertexLayout<V> && HasVertexLayout<I>
+    constexpr const SDL_GPUVertexInputState& instanced_vertex_input_state() {
+        return InstancedVertexInput<V, I>::state;
+    }
+
+    // ------------------------------------------------------------------------
+    // Packing helpers
+    // ------------------------------------------------------------------------
+
+    // IEEE 754 binary16 (round to nearest, flushes denormals to zero)
+    constexpr uint16_t pack_half(float value) {
+        uint32_t bits = std::bit_cast<uint32_t>(value);
+        uint32_t sign = (bits >> 16) & 0x8000u;
+        int32_t exponent = static_cast<int32_t>((bits >> 23) & 0xFFu) - 127 + 15;
+        uint32_t mantissa = bits & 0x7FFFFFu;
+
+        if (exponent <= 0) {
+            return static_cast<uint16_t>(sign);
+        }
+        if (exponent >= 31) {
+            // Overflow to infinity, keep NaN as NaN
+            bool isNan = ((bits >> 23) & 0xFFu) == 0xFFu && mantissa != 0;
+            return static_cast<uint16_t>(sign | 0x7C00u | (isNan ? 0x200u : 0u));
+        }
+
+        uint32_t half = sign | (static_cast<uint32_t>(exponent) << 10) | (mantissa >> 13);
+        if (mantissa & 0x1000u) {
+            half++; // Round half up; carries into the exponent correctly
+        }
+        return static_cast<uint16_t>(half);
+    }
+
+    constexpr float unpack_half(uint16_t half) {
+        uint32_t sign = static_cast<uint32_t>(half & 0x8000u) << 16;
+        uint32_t exponent = (half >> 10) & 0x1Fu;
+        uint32_t mantissa = half & 0x3FFu;
+
+        if (exponent == 0) {
+            return std::bit_cast<float>(sign); // Zero (denormals flushed)
+        }
+        if (exponent == 31) {
+            return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+        }
+        return std::bit_cast<float>(sign | ((exponent - 15 + 127) << 23) | (mantissa << 13));
+    }
+
+    constexpr uint8_t pack_unorm8(float value) {
+        return static_cast<uint8_t>(std::clamp(value, 0.0f, 1.0f) * 255.0f + 0.5f);
+    }
+
+    constexpr int8_t pack_snorm8(float value) {
+        float scaled = std::clamp(value, -1.0f, 1.0f) * 127.0f;
+        return static_cast<int8_t>(scaled >= 0.0f ? scaled + 0.5f : scaled - 0.5f);
+    }
+
+    // Unsigned 8.8 fixed point, covering [0, 256) with 1/256 precision (chunk-local positions)
+    constexpr uint16_t pack_fixed_8_8(float value) {
+        return static_cast<uint16_t>(std::clamp(value, 0.0f, 255.99609375f) * 256.0f + 0.5f);
+    }
+
+    // ------------------------------------------------------------------------
+    // Vertex formats
+    // ------------------------------------------------------------------------
+
+    // Vertex structure for 3D models (28 bytes)
+    struct Vertex {
+        float position[3];  // x, y, z
+        float color[4];     // r, g, b, a
+
+        Vertex() = default;
+        Vertex(float x, float y, float z, float r, float g, float b, float a = 1.0f)
+            : position{x, y, z}, color{r, g, b, a} {}
+    };
+
+    template<>
+    struct VertexLayout<Vertex> {
+        static constexpr std::array attributes{
+            vertex_attribute(0, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT3, offsetof(Vertex, position)),
+            vertex_attribute(1, SDL_GPU_VERTEXELEMENTFORMAT_FLOAT4, offsetof(Vertex, color)),
+        };
+        static constexpr std::array<float, 3> position(const Vertex& vertex) {
+            return {vertex.position[0], vertex.position[1], vertex.position[2]};
+        }
+    };
+
+    // Half-float position with UNORM8 color and SNORM8 normal (16 bytes)
+    struct HalfVertex {
+        uint16_t position[4];   // x, y, z as binary16, w = 1.0
+        uint8_t color[4];       // r, g, b, a
+        int8_t normal[4];       // x, y, z, w unused
+
+        HalfVertex() = default;
+        HalfVertex(float x, float y, float z, float r, float g, float b, float a = 1.0f,
+                   float nx = 0.0f, float ny = 1.0f, float nz = 0.0f)
+            : position{pack_half(x), pack_half(y), pack_half(z), pack_half(1.0f)}
+            , color{pack_unorm8(r), pack_unorm8(g), pack_unorm8(b), pack_unorm8(a)}
+            , normal{pack_snorm8(nx), pack_snorm8(ny), pack_snorm8(nz), 0} {}
+    };
+
+    template<>
+    struct VertexLayout<HalfVertex> {
+        static constexpr std::array attributes{
+            vertex_attribute(0, SDL_GPU_VERTEXELEMENTFORMAT_HALF4, offsetof(HalfVertex, position)),
+            vertex_attribute(1, SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM, offsetof(HalfVertex, color)),
+            vertex_attribute(2, SDL_GPU_VERTEXELEMENTFORMAT_BYTE4_NORM, offsetof(HalfVertex, normal)),
+        };
+        static constexpr std::array<float, 3> position(const HalfVertex& vertex) {
+            return {unpack_half(vertex.position[0]), unpack_half(vertex.position[1]), unpack_half(vertex.position[2])};
+        }
+    };
+
+    // Voxel face directions, stored in VoxelVertex::position[3]
+    enum class VoxelFace : uint16_t {
+        PositiveX = 0, NegativeX, PositiveY, NegativeY, PositiveZ, NegativeZ
+    };
+
+    // Chunk-local voxel vertex (12 bytes). Positions are 8.8 fixed point relative
+    // to the chunk origin (divide by 256 in the shader); the fourth component holds
+    // the face direction, from which the shader derives the normal.
+    struct VoxelVertex {
+        uint16_t position[4];   // x, y, z in 8.8 fixed point, w = VoxelFace
+        uint8_t color[4];       // r, g, b, a
+
+        VoxelVertex() = default;
+        VoxelVertex(float x, float y, float z, VoxelFace face, float r, float g, float b, float a = 1.0f)
+            : position{pack_fixed_8_8(x), pack_fixed_8_8(y), pack_fixed_8_8(z), static_cast<uint16_t>(face)}
+            , color{pack_unorm8(r), pack_unorm8(g), pack_unorm8(b), pack_unorm8(a)} {}
+    };
+
+    template<>
+    struct VertexLayout<VoxelVertex> {
+        static constexpr std::array attributes{
+            vertex_attribute(0, SDL_GPU_VERTEXELEMENTFORMAT_USHORT4, offsetof(VoxelVertex, position)),
+            vertex_attribute(1, SDL_GPU_VERTEXELEMENTFORMAT_UBYTE4_NORM, offsetof(VoxelVertex, color)),
+        };
+        // Chunk-local position; the chunk's world offset is applied by the caller
+        static constexpr std::array<float, 3> position(const VoxelVertex& vertex) {
+            return {vertex.position[0] / 256.0f, vertex.position[1] / 256.0f, vertex.position[2] / 256.0f};
+        }
+    };
+
+    static_assert(sizeof(Vertex) == 28);
+    static_assert(sizeof(HalfVertex) == 16);
+    static_assert(sizeof(VoxelVertex) == 12);
+
+} // namespace minecart::graphics
@@ -10,9 +10,15 @@
 #include <stdexcept>
 #include <string>
 
-// Forward declaration of Game class
+#include "minecart/buffer_arena.hpp"
+#include "minecart/simulation_thread.hpp"
+#include "minecart/staging_ring.hpp"
+#include "minecart/upload_queue.hpp"
+
+// Forward declarations of Game and JobSystem classes
 namespace minecart {
     class Game;
+    class JobSystem;
 }
 
 namespace minecart::graphics {
@@ -53,11 +59,23 @@ namespace minecart::graphics {
     using SDLWindowPtr = std::unique_ptr<SDL_Window, SDLWindowDeleter>;
     using SDLGPUDevicePtr = std::unique_ptr<SDL_GPUDevice, SDLGPUDeviceDeleter>;
 
+    // Trade latency against throughput: present mode, how many frames the CPU may
+    // run ahead of the GPU, and an optional frame-rate cap
+    struct FramePacing {
+        SDL_GPUPresentMode presentMode = SDL_GPU_PRESENTMODE_VSYNC;    // Falls back to vsync if unsupported
+        uint32_t framesInFlight = 2;                                    // 1 (lowest latency) to 3
+        double maxFrameRate = 0.0;                                      // Frames per second, 0 = uncapped
+    };
+
     struct FrameContext {
         SDL_GPUCommandBuffer* commandBuffer;
         SDL_GPURenderPass* renderPass;
         SDL_Window* window;
         SDL_GPUDevice* device;
+        UploadQueue* uploadQueue;
+        JobSystem* jobSystem;       // Spread culling, meshing and animation across cores
+        float deltaTime;            // Seconds since the previous frame
+        float interpolationAlpha;   // Progress (0-1) from the previous to the current simulation step
     };
 
     class Window {
@@ -89,18 +107,44 @@ namespace minecart::graphics {
         [[nodiscard]] SDL_GPUDevice* get_device() const noexcept { return device.get(); }
         [[nodiscard]] bool is_initialized() const noexcept { return initialized; }
         [[nodiscard]] SDL_FColor get_clear_color() const noexcept { return clearColor; }
+        [[nodiscard]] UploadQueue* get_upload_queue() const noexcept { return m_uploadQueue.get(); }
+        [[nodiscard]] StagingRing* get_staging_ring() const noexcept { return m_stagingRing.get(); }
+        [[nodiscard]] GpuBufferArena* get_buffer_arena() const noexcept { return m_bufferArena.get(); }
+        [[nodiscard]] SimulationThread* get_simulation_thread() const noexcept { return m_simulationThread.get(); }
+
+        [[nodiscard]] const FramePacing& get_frame_pacing() const noexcept { return m_framePacing; }
+        [[nodiscard]] SDL_GPUPresentMode get_present_mode() const noexcept { return m_presentMode; }
 
         // Modifiers
         void set_clear_color(const SDL_FColor& color) noexcept { clearColor = color; }
 
+        // Applied immediately once initialized, otherwise during initialize()
+        void set_frame_pacing(const FramePacing& pacing);
+
     private:
         SDLWindowPtr window;
         SDLGPUDevicePtr device;
+        std::unique_ptr<StagingRing> m_stagingRing;
+        std::unique_ptr<UploadQueue> m_uploadQueue;
+        std::unique_ptr<GpuBufferArena> m_bufferArena;
+        std::unique_ptr<SimulationThread> m_simulationThread;   // Only in pipelined mode
         Game* game;  // Non-owning pointer to game instance
         SDL_FColor clearColor = {0.1f, 0.1f, 0.1f, 1.0f};
         bool initialized = false;
         bool imguiInitialized = false;
-        uint64_t m_lastFrameTime = 0;
+        // Longest frame time fed to the fixed-update accumulator (250 ms)
+        static constexpr uint64_t MAX_ACCUMULATED_TIME = 250'000'000;
+
+        // Run due fixed updates; false if the game asked to exit
+        bool run_fixed_updates(uint64_t frameTime);
+        void apply_frame_pacing();
+
+        FramePacing m_framePacing;
+        SDL_GPUPresentMode m_presentMode = SDL_GPU_PRESENTMODE_VSYNC;  // In effect after fallback
+        uint64_t m_lastFrameTime = 0;           // SDL_GetTicksNS() at the start of the last frame
+        uint64_t m_accumulatedTime = 0;         // Nanoseconds not yet consumed by fixed updates
+        float m_deltaTime = 0.0f;
+        float m_interpolationAlpha = 0.0f;
     };
 
 } // namespace minecart::graphics
\ No newline at end of file
@@ -0,0 +1,347 @@
+#include "minecart/buffer_arena.hpp"
+#include "minecart/gpu_stats.hpp"
+
+#include <algorithm>
+
+namespace minecart::graphics {
+
+    static uint32_t align_up(uint32_t value, uint32_t alignment) {
+        return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+    }
+
+    GpuBufferArena::GpuBufferArena(SDL_GPUDevice* device, SDL_GPUBufferUsageFlags usage, uint32_t pageSize, UploadQueue* uploadQueue)
+        : m_device(device)
+        , m_uploadQueue(uploadQueue)
+        , m_usage(usage)
+        , m_pageSize(pageSize)
+    {
+        if (!device) {
+            throw ArenaException("Device cannot be null");
+        }
+        if (pageSize == 0) {
+            throw ArenaException("Page size cannot be zero");
+        }
+    }
+
+    GpuBufferArena::~GpuBufferArena() {
+        for (Page& page : m_pages) {
+            release_page(page);
+        }
+    }
+
+    uint32_t GpuBufferArena::create_page(uint32_t size) {
+        SDL_GPUBufferCreateInfo bufferInfo{};
+        bufferInfo.usage = m_usage;
+        bufferInfo.size = size;
+
+        SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+        if (!buffer) {
+            throw ArenaException(std::string("Failed to create arena page: ") + SDL_GetError());
+        }
+        GpuStats::get().track_buffer(buffer, size);
+
+        Page page;
+        page.buffer = buffer;
+        page.size = size;
+        insert_free(page, 0, size);
+        m_pages.push_back(std::move(page));
+        return static_cast<uint32_t>(m_pages.size() - 1);
+    }
+
+    void GpuBufferArena::release_page(Page& page) noexcept {
+        if (!page.buffer) {
+            return;
+        }
+        if (m_uploadQueue) {
+            m_uploadQueue->discard(page.buffer);
+        }
+        GpuStats::get().untrack_buffer(page.buffer);
+        SDL_ReleaseGPUBuffer(m_device, page.buffer);
+        page.buffer = nullptr;
+    }
+
+    void GpuBufferArena::insert_free(Page& page, uint32_t offset, uint32_t size) {
+        page.freeByOffset.emplace(offset, size);
+        page.freeBySize.emplace(size, offset);
+    }
+
+    void GpuBufferArena::erase_free(Page& page, uint32_t offset, uint32_t size) {
+        page.freeByOffset.erase(offset);
+        auto [first, last] = page.freeBySize.equal_range(size);
+        for (auto it = first; it != last; ++it) {
+            if (it->second == offset) {
+                page.freeBySize.erase(it);
+                break;
+            }
+        }
+    }
+
+    bool GpuBufferArena::try_allocate_in_page(uint32_t pageIndex, uint32_t size, uint32_t alignment, Slot& slot) {
+        Page& page = m_pages[pageIndex];
+
+        // Best fit: smallest free block that still fits once its start is aligned
+        for (auto it = page.freeBySize.lower_bound(size); it != page.freeBySize.end(); ++it) {
+            uint32_t blockSize = it->first;
+            uint32_t blockOffset = it->second;
+            uint32_t offset = align_up(blockOffset, alignment);
+            uint32_t padding = offset - blockOffset;
+
+            if (padding > blockSize || size > blockSize - padding) {
+                continue;
+            }
+
+            erase_free(page, blockOffset, blockSize);
+            uint32_t used = padding + size;
+            if (blockSize > used) {
+                insert_free(page, blockOffset + used, blockSize - used);
+            }
+
+            slot.page = pageIndex;
+            slot.offset = offset;
+            slot.blockOffset = blockOffset;
+            slot.blockSize = used;
+            slot.size = size;
+            slot.alignment = alignment;
+            slot.live = true;
+            return true;
+        }
+        return false;
+    }
+
+    GpuBufferArena::Handle GpuBufferArena::allocate(uint32_t size, uint32_t alignment) {
+        if (size == 0) {
+            throw ArenaException("Cannot allocate zero bytes");
+        }
+        alignment = std::max(alignment, 1u);
+
+        Slot slot;
+        bool placed = false;
+        for (uint32_t i = 0; i < m_pages.size() && !placed; ++i) {
+            placed = try_allocate_in_page(i, size, alignment, slot);
+        }
+        if (!placed) {
+            uint32_t pageSize = std::max(m_pageSize, size + alignment - 1);
+            placed = try_allocate_in_page(create_page(pageSize), size, alignment, slot);
+        }
+        if (!placed) {
+            throw ArenaException("Allocation does not fit in a fresh page");
+        }
+
+        Handle handle;
+        if (!m_freeSlots.empty()) {
+            handle = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            m_slots[handle - 1] = slot;
+        } else {
+            m_slots.push_back(slot);
+            handle = static_cast<Handle>(m_slots.size());
+        }
+        return handle;
+    }
+
+    void GpuBufferArena::free(Handle handle) noexcept {
+        if (handle == INVALID_HANDLE || handle > m_slots.size() || !m_slots[handle - 1].live) {
+            return;
+        }
+
+        Slot& slot = m_slots[handle - 1];
+        Page& page = m_pages[slot.page];
+        uint32_t offset = slot.blockOffset;
+        uint32_t size = slot.blockSize;
+
+        // Copies still queued for this range must not land on its next owner
+        if (m_uploadQueue) {
+            m_uploadQueue->discard(page.buffer, offset, size);
+        }
+
+        // Coalesce with the following free block
+        auto next = page.freeByOffset.lower_bound(offset);
+        if (next != page.freeByOffset.end() && next->first == offset + size) {
+            uint32_t nextOffset = next->first;
+            uint32_t nextSize = next->second;
+            erase_free(page, nextOffset, nextSize);
+            size += nextSize;
+        }
+
+        // Coalesce with the preceding free block
+        auto prev = page.freeByOffset.lower_bound(offset);
+        if (prev != page.freeByOffset.begin()) {
+            --prev;
+            if (prev->first + prev->second == offset) {
+                uint32_t prevOffset = prev->first;
+                uint32_t prevSize = prev->second;
+                erase_free(page, prevOffset, prevSize);
+                offset = prevOffset;
+                size += prevSize;
+            }
+        }
+
+        insert_free(page, offset, size);
+
+        slot.live = false;
+        m_freeSlots.push_back(handle);
+    }
+
+    ArenaRegion GpuBufferArena::get_region(Handle handle) const {
+        if (handle == INVALID_HANDLE || handle > m_slots.size() || !m_slots[handle - 1].live) {
+            throw ArenaException("Invalid allocation handle");
+        }
+        const Slot& slot = m_slots[handle - 1];
+        return ArenaRegion{m_pages[slot.page].buffer, slot.offset, slot.size};
+    }
+
+    void GpuBufferArena::defragment() {
+        // Pending uploads still target the current placements
+        if (m_uploadQueue) {
+            m_uploadQueue->flush();
+        }
+
+        std::vector<std::vector<Handle>> livePerPage(m_pages.size());
+        for (Handle handle = 1; handle <= m_slots.size(); ++handle) {
+            if (m_slots[handle - 1].live) {
+                livePerPage[m_slots[handle - 1].page].push_back(handle);
+            }
+        }
+
+        SDL_GPUCommandBuffer* commandBuffer = nullptr;
+        SDL_GPUCopyPass* copyPass = nullptr;
+        std::vector<SDL_GPUBuffer*> retired;
+        uint64_t bytesMoved = 0;
+
+        for (uint32_t pageIndex = 0; pageIndex < m_pages.size(); ++pageIndex) {
+            std::vector<Handle>& handles = livePerPage[pageIndex];
+            if (handles.empty()) {
+                continue;
+            }
+            std::sort(handles.begin(), handles.end(), [this](Handle a, Handle b) {
+                return m_slots[a - 1].blockOffset < m_slots[b - 1].blockOffset;
+            });
+
+            // Work out the packed layout first; skip pages that are already tight
+            std::vector<uint32_t> packedOffsets(handles.size());
+            uint32_t cursor = 0;
+            bool moved = false;
+            for (size_t i = 0; i < handles.size(); ++i) {
+                const Slot& slot = m_slots[handles[i] - 1];
+                packedOffsets[i] = align_up(cursor, slot.alignment);
+                moved |= packedOffsets[i] != slot.offset;
+                cursor = packedOffsets[i] + slot.size;
+            }
+            if (!moved) {
+                continue;
+            }
+
+            if (!commandBuffer) {
+                commandBuffer = SDL_AcquireGPUCommandBuffer(m_device);
+                if (!commandBuffer) {
+                    throw ArenaException(std::string("Failed to acquire command buffer: ") + SDL_GetError());
+                }
+                copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+                if (!copyPass) {
+                    SDL_SubmitGPUCommandBuffer(commandBuffer);
+                    throw ArenaException(std::string("Failed to begin copy pass: ") + SDL_GetError());
+                }
+            }
+
+            Page& page = m_pages[pageIndex];
+            SDL_GPUBufferCreateInfo bufferInfo{};
+            bufferInfo.usage = m_usage;
+            bufferInfo.size = page.size;
+
+            SDL_GPUBuffer* packed = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+            if (!packed) {
+                SDL_EndGPUCopyPass(copyPass);
+                SDL_SubmitGPUCommandBuffer(commandBuffer);
+                for (SDL_GPUBuffer* buffer : retired) {
+                    GpuStats::get().untrack_buffer(buffer);
+                    SDL_ReleaseGPUBuffer(m_device, buffer);
+                }
+                throw ArenaException(std::string("Failed to create arena page: ") + SDL_GetError());
+            }
+            GpuStats::get().track_buffer(packed, page.size);
+
+            uint32_t blockStart = 0;
+            for (size_t i = 0; i < handles.size(); ++i) {
+                Slot& slot = m_slots[handles[i] - 1];
+
+                SDL_GPUBufferLocation src{};
+                src.buffer = page.buffer;
+                src.offset = slot.offset;
+
+                SDL_GPUBufferLocation dst{};
+                dst.buffer = packed;
+                dst.offset = packedOffsets[i];
+
+                SDL_CopyGPUBufferToBuffer(copyPass, &src, &dst, slot.size, false);
+                bytesMoved += slot.size;
+
+                slot.offset = packedOffsets[i];
+                slot.blockOffset = blockStart;
+                slot.blockSize = packedOffsets[i] + slot.size - blockStart;
+                blockStart = packedOffsets[i] + slot.size;
+            }
+
+            retired.push_back(page.buffer);
+            page.buffer = packed;
+            page.freeByOffset.clear();
+            page.freeBySize.clear();
+            if (blockStart < page.size) {
+                insert_free(page, blockStart, page.size - blockStart);
+            }
+        }
+
+        if (commandBuffer) {
+            SDL_EndGPUCopyPass(copyPass);
+            if (!SDL_SubmitGPUCommandBuffer(commandBuffer)) {
+                throw ArenaException(std::string("Failed to submit defragmentation: ") + SDL_GetError());
+            }
+            // Released once the copies have executed
+            for (SDL_GPUBuffer* buffer : retired) {
+                GpuStats::get().untrack_buffer(buffer);
+                SDL_ReleaseGPUBuffer(m_device, buffer);
+            }
+        }
+
+        // Drop pages without live allocations and renumber the rest
+        std::vector<uint32_t> remap(m_pages.size());
+        std::vector<Page> kept;
+        for (uint32_t pageIndex = 0; pageIndex < m_pages.size(); ++pageIndex) {
+            if (livePerPage[pageIndex].empty()) {
+                release_page(m_pages[pageIndex]);
+                continue;
+            }
+            remap[pageIndex] = static_cast<uint32_t>(kept.size());
+            kept.push_back(std::move(m_pages[pageIndex]));
+        }
+        m_pages = std::move(kept);
+        for (Slot& slot : m_slots) {
+            if (slot.live) {
+                slot.page = remap[slot.page];
+            }
+        }
+
+        m_defragmentations++;
+        m_bytesMoved += bytesMoved;
+    }
+
+    GpuBufferArenaStats GpuBufferArena::get_stats() const noexcept {
+        GpuBufferArenaStats stats;
+        stats.pages = static_cast<uint32_t>(m_pages.size());
+        for (const Page& page : m_pages) {
+            stats.capacityBytes += page.size;
+            if (!page.freeBySize.empty()) {
+                stats.largestFreeBlock = std::max<uint64_t>(stats.largestFreeBlock, page.freeBySize.rbegin()->first);
+            }
+        }
+        for (const Slot& slot : m_slots) {
+            if (slot.live) {
+                stats.allocations++;
+                stats.usedBytes += slot.size;
+            }
+        }
+        stats.defragmentations = m_defragmentations;
+        stats.bytesMoved = m_bytesMoved;
+        return stats;
+    }
+
+} // namespace minecart::graphics
@@ -6,27 +6,30 @@
 
 namespace minecart::graphics {
 
-    constexpr glm::vec3 WORLD_UP = glm::vec3(0.0f, 1.0f, 0.0f);
-
-    Camera::Camera() {
-        update();
+    Camera::Camera() = default;
+
+    bool Camera::clean(uint32_t flag) const noexcept {
+        if (m_dirty & flag) {
+            m_dirty &= ~flag;
+            return false;
+        }
+        return true;
     }
 
     void Camera::set_position(const glm::vec3& pos) {
         m_position = pos;
-        update();
+        m_dirty |= DIRTY_POSITION;
     }
 
     void Camera::set_position(float x, float y, float z) {
-        m_position = glm::vec3{x, y, z};
-        update();
+        set_position(glm::vec3{x, y, z});
     }
 
     void Camera::set_rotation(float pitch, float yaw) {
         // Clamp pitch to avoid gimbal lock
         m_pitch = std::clamp(pitch, -1.5533f, 1.5533f);  // ~89 degrees
         m_yaw = yaw;
-        update();
+        m_dirty |= DIRTY_ORIENTATION;
     }
 
     void Camera::look_at(const glm::vec3& target) {
@@ -38,44 +41,64 @@ namespace minecart::graphics {
         // Calculate yaw (horizontal angle)
         m_yaw = std::atan2(direction.x, -direction.z);
 
-        update();
+        m_dirty |= DIRTY_ORIENTATION;
     }
 
     void Camera::set_perspective(float fovY, float aspect, float nearZ, float farZ) {
+        m_projectionMode = ProjectionMode::Standard;
         m_fovY = fovY;
         m_aspect = aspect;
         m_nearZ = nearZ;
         m_farZ = farZ;
-        m_projectionMatrix = glm::perspective(fovY, aspect, nearZ, farZ);
+        m_dirty |= DIRTY_PROJECTION_ALL;
+    }
+
+    void Camera::set_reverse_z_infinite(float fovY, float aspect, float nearZ) {
+        m_projectionMode = ProjectionMode::ReverseZInfinite;
+        m_fovY = fovY;
+        m_aspect = aspect;
+        m_nearZ = nearZ;
+        m_dirty |= DIRTY_PROJECTION_ALL;
     }
 
     void Camera::set_aspect_ratio(float aspect) {
         m_aspect = aspect;
-        m_projectionMatrix = glm::perspective(m_fovY, m_aspect, m_nearZ, m_farZ);
+        m_dirty |= DIRTY_PROJECTION_ALL;
     }
 
     void Camera::move_forward(float distance) {
-        m_position += m_forward * distance;
-        update();
+        m_position += get_forward() * distance;
+        m_dirty |= DIRTY_POSITION;
     }
 
     void Camera::move_right(float distance) {
-        m_position += m_right * distance;
-        update();
+        m_position += get_right() * distance;
+        m_dirty |= DIRTY_POSITION;
     }
 
     void Camera::move_up(float distance) {
         m_position += WORLD_UP * distance;
-        update();
+        m_dirty |= DIRTY_POSITION;
     }
 
     void Camera::rotate(float deltaPitch, float deltaYaw) {
         m_pitch = std::clamp(m_pitch + deltaPitch, -1.5533f, 1.5533f);
         m_yaw += deltaYaw;
-        update();
+        m_dirty |= DIRTY_ORIENTATION;
     }
 
     void Camera::update() {
+        (void)get_inverse_view_projection();
+        (void)get_inverse_view();
+        (void)get_inverse_projection();
+        (void)get_frustum();
+    }
+
+    void Camera::update_vectors() const {
+        if (clean(DIRTY_VECTORS)) {
+            return;
+        }
+
         // Calculate forward vector from pitch and yaw
         m_forward.x = std::sin(m_yaw) * std::cos(m_pitch);
         m_forward.y = std::sin(m_pitch);
@@ -85,9 +108,66 @@ namespace minecart::graphics {
         // Recalculate right and up vectors
         m_right = glm::normalize(glm::cross(m_forward, WORLD_UP));
         m_up = glm::normalize(glm::cross(m_right, m_forward));
+    }
+
+    const glm::mat4& Camera::get_view_matrix() const {
+        if (!clean(DIRTY_VIEW)) {
+            update_vectors();
+            m_viewMatrix = glm::lookAt(m_position, m_position + m_forward, WORLD_UP);
+        }
+        return m_viewMatrix;
+    }
+
+    const glm::mat4& Camera::get_projection_matrix() const {
+        if (!clean(DIRTY_PROJECTION)) {
+            if (m_projectionMode == ProjectionMode::ReverseZInfinite) {
+                // Right-handed, [0, 1] depth: z_ndc = near / -z_view, 1 at the near plane and 0 at infinity
+                float focal = 1.0f / std::tan(m_fovY * 0.5f);
+                m_projectionMatrix = glm::mat4(0.0f);
+                m_projectionMatrix[0][0] = focal / m_aspect;
+                m_projectionMatrix[1][1] = focal;
+                m_projectionMatrix[2][3] = -1.0f;
+                m_projectionMatrix[3][2] = m_nearZ;
+            } else {
+                m_projectionMatrix = glm::perspective(m_fovY, m_aspect, m_nearZ, m_farZ);
+            }
+        }
+        return m_projectionMatrix;
+    }
+
+    const glm::mat4& Camera::get_view_projection() const {
+        if (!clean(DIRTY_VIEW_PROJECTION)) {
+            m_viewProjection = get_projection_matrix() * get_view_matrix();
+        }
+        return m_viewProjection;
+    }
+
+    const glm::mat4& Camera::get_inverse_view() const {
+        if (!clean(DIRTY_INVERSE_VIEW)) {
+            m_inverseView = glm::inverse(get_view_matrix());
+        }
+        return m_inverseView;
+    }
+
+    const glm::mat4& Camera::get_inverse_projection() const {
+        if (!clean(DIRTY_INVERSE_PROJECTION)) {
+            m_inverseProjection = glm::inverse(get_projection_matrix());
+        }
+        return m_inverseProjection;
+    }
+
+    const glm::mat4& Camera::get_inverse_view_projection() const {
+        if (!clean(DIRTY_INVERSE_VIEW_PROJECTION)) {
+            m_inverseViewProjection = get_inverse_view() * get_inverse_projection();
+        }
+        return m_inverseViewProjection;
+    }
 
-        m_viewMatrix = glm::lookAt(m_position, m_position + m_forward, WORLD_UP);
-        // m_projectionMatrix is updated elsewhere
+    const Frustum& Camera::get_frustum() const {
+        if (!clean(DIRTY_FRUSTUM)) {
+            m_frustum = Frustum::from_matrix(get_view_projection(), m_projectionMode == ProjectionMode::ReverseZInfinite);
+        }
+        return m_frustum;
     }
 
 } // namespace minecart::graphics
@@ -0,0 +1,475 @@
+#include "minecart/chunk.hpp"
+
+#include <algorithm>
+
+namespace minecart::world {
+
+    namespace {
+
+        // Narrowest supported index width for a palette of the given size
+        uint32_t bits_for_palette(size_t size) noexcept {
+            if (size <= 1) return 0;
+            if (size <= 2) return 1;
+            if (size <= 4) return 2;
+            if (size <= 16) return 4;
+            if (size <= 256) return 8;
+            return 16;
+        }
+
+    } // namespace
+
+    ChunkSection::ChunkSection(BlockId fill) {
+        this->fill(fill);
+    }
+
+    BlockId ChunkSection::get_at(uint32_t index) const noexcept {
+        if (m_bits == 0) {
+            return m_palette[0];
+        }
+        uint32_t value = read(index);
+        return m_bits == DIRECT_BITS ? static_cast<BlockId>(value) : m_palette[value];
+    }
+
+    uint32_t ChunkSection::read(uint32_t index) const noexcept {
+        // Widths divide 64, so an entry never straddles two words
+        uint32_t bit = index * m_bits;
+        uint64_t mask = (uint64_t{1} << m_bits) - 1;
+        return static_cast<uint32_t>((m_data[bit >> 6] >> (bit & 63)) & mask);
+    }
+
+    void ChunkSection::write(uint32_t index, uint32_t value) noexcept {
+        uint32_t bit = index * m_bits;
+        uint64_t mask = (uint64_t{1} << m_bits) - 1;
+        uint64_t& word = m_data[bit >> 6];
+        word = (word & ~(mask << (bit & 63))) | (static_cast<uint64_t>(value) << (bit & 63));
+    }
+
+    BlockId ChunkSection::set_at(uint32_t index, BlockId block) {
+        BlockId previous = get_at(index);
+        if (previous == block) {
+            return previous;
+        }
+
+        uint32_t value = palette_index(block);
+        write(index, value);
+
+        if (previous == AIR) {
+            m_nonAirCount++;
+        } else if (block == AIR) {
+            m_nonAirCount--;
+        }
+        return previous;
+    }
+
+    uint32_t ChunkSection::palette_index(BlockId block) {
+        if (m_bits == DIRECT_BITS) {
+            return block;
+        }
+
+        auto it = std::find(m_palette.begin(), m_palette.end(), block);
+        if (it != m_palette.end()) {
+            return static_cast<uint32_t>(it - m_palette.begin());
+        }
+
+        // Room left at the current width
+        if (m_bits > 0 && m_palette.size() < (size_t{1} << m_bits)) {
+            m_palette.push_back(block);
+            return static_cast<uint32_t>(m_palette.size() - 1);
+        }
+
+        // Full: reclaim entries no longer referenced before widening
+        if (m_bits > 0) {
+            compact();
+            if (m_palette.size() < (size_t{1} << m_bits)) {
+                m_palette.push_back(block);
+                return static_cast<uint32_t>(m_palette.size() - 1);
+            }
+        }
+
+        // Widen, keeping existing palette indices
+        std::array<BlockId, SECTION_VOLUME> values{};
+        for (uint32_t i = 0; m_bits > 0 && i < SECTION_VOLUME; ++i) {
+            values[i] = static_cast<BlockId>(read(i));
+        }
+
+        std::vector<BlockId> palette = m_palette;
+        palette.push_back(block);
+        uint32_t bits = bits_for_palette(palette.size());
+        if (bits == DIRECT_BITS) {
+            for (BlockId& value : values) {
+                value = palette[value];
+            }
+            repack(bits, {}, values);
+            return block;
+        }
+        repack(bits, palette, values);
+        return static_cast<uint32_t>(palette.size() - 1);
+    }
+
+    void ChunkSection::repack(uint32_t bits, const std::vector<BlockId>& palette, std::span<const BlockId, SECTION_VOLUME> values) {
+        m_bits = bits;
+        m_palette = palette;
+        m_palette.shrink_to_fit();
+        if (bits == 0) {
+            m_data.clear();
+            m_data.shrink_to_fit();
+            return;
+        }
+
+        m_data.assign(SECTION_VOLUME * bits / 64, 0);
+        m_data.shrink_to_fit();
+        for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+            write(i, values[i]);
+        }
+    }
+
+    void ChunkSection::fill(BlockId block) {
+        m_bits = 0;
+        m_palette.assign(1, block);
+        m_palette.shrink_to_fit();
+        m_data.clear();
+        m_data.shrink_to_fit();
+        m_nonAirCount = block == AIR ? 0 : SECTION_VOLUME;
+    }
+
+    void ChunkSection::fill(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockId block) {
+        minX = std::max(minX, 0);
+        minY = std::max(minY, 0);
+        minZ = std::max(minZ, 0);
+        maxX = std::min(maxX, SECTION_SIZE);
+        maxY = std::min(maxY, SECTION_SIZE);
+        maxZ = std::min(maxZ, SECTION_SIZE);
+        if (minX >= maxX || minY >= maxY || minZ >= maxZ) {
+            return;
+        }
+        if (minX == 0 && minY == 0 && minZ == 0 && maxX == SECTION_SIZE && maxY == SECTION_SIZE && maxZ == SECTION_SIZE) {
+            fill(block);
+            return;
+        }
+        if (m_bits == 0 && m_palette[0] == block) {
+            return;
+        }
+
+        uint32_t value = palette_index(block);
+        for (int y = minY; y < maxY; ++y) {
+            for (int z = minZ; z < maxZ; ++z) {
+                for (int x = minX; x < maxX; ++x) {
+                    uint32_t index = section_index(x, y, z);
+                    BlockId previous = get_at(index);
+                    if (previous == block) {
+                        continue;
+                    }
+                    write(index, value);
+                    if (previous == AIR) {
+                        m_nonAirCount++;
+                    } else if (block == AIR) {
+                        m_nonAirCount--;
+                    }
+                }
+            }
+        }
+    }
+
+    void ChunkSection::get_all(std::span<BlockId, SECTION_VOLUME> out) const noexcept {
+        for_each([&](uint32_t index, BlockId block) { out[index] = block; });
+    }
+
+    void ChunkSection::set_all(std::span<const BlockId, SECTION_VOLUME> data) {
+        std::vector<BlockId> palette;
+        std::array<BlockId, SECTION_VOLUME> values{};
+        std::unordered_map<BlockId, BlockId> lookup;
+        m_nonAirCount = 0;
+
+        bool direct = false;
+        for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+            BlockId block = data[i];
+            if (block != AIR) {
+                m_nonAirCount++;
+            }
+            if (direct) {
+                values[i] = block;
+                continue;
+            }
+
+            auto [it, inserted] = lookup.try_emplace(block, static_cast<BlockId>(palette.size()));
+            if (inserted) {
+                palette.push_back(block);
+                if (palette.size() > 256) {
+                    // Too many types for a palette: store ids directly from here on
+                    direct = true;
+                    for (uint32_t j = 0; j < i; ++j) {
+                        values[j] = palette[values[j]];
+                    }
+                    values[i] = block;
+                    continue;
+                }
+            }
+            values[i] = it->second;
+        }
+
+        if (direct) {
+            repack(DIRECT_BITS, {}, values);
+        } else {
+            repack(bits_for_palette(palette.size()), palette, values);
+        }
+    }
+
+    void ChunkSection::compact() {
+        if (m_bits == 0) {
+            return;
+        }
+
+        std::array<BlockId, SECTION_VOLUME> values{};
+        for (uint32_t i = 0; i < SECTION_VOLUME; ++i) {
+            values[i] = static_cast<BlockId>(read(i));
+        }
+
+        std::vector<BlockId> palette;
+        if (m_bits == DIRECT_BITS) {
+            std::unordered_map<BlockId, BlockId> lookup;
+            for (BlockId& value : values) {
+                auto [it, inserted] = lookup.try_emplace(value, static_cast<BlockId>(palette.size()));
+                if (inserted) {
+                    palette.push_back(value);
+                    if (palette.size() > 256) {
+                        return; // Still too diverse for a palette
+                    }
+                }
+                value = it->second;
+            }
+        } else {
+            // Remap the palette indices that are still referenced, in order of first use
+            constexpr BlockId UNUSED = 0xFFFF;
+            std::vector<BlockId> remap(m_palette.size(), UNUSED);
+            for (BlockId& value : values) {
+                if (remap[value] == UNUSED) {
+                    remap[value] = static_cast<BlockId>(palette.size());
+                    palette.push_back(m_palette[value]);
+                }
+                value = remap[value];
+            }
+        }
+
+        repack(bits_for_palette(palette.size()), palette, values);
+    }
+
+    size_t ChunkSection::get_memory_usage() const noexcept {
+        return sizeof(*this) + m_palette.capacity() * sizeof(BlockId) + m_data.capacity() * sizeof(uint64_t);
+    }
+
+    Chunk::Chunk(ChunkPos position, uint32_t sectionCount)
+        : m_position(position)
+    {
+        if (sectionCount == 0 || sectionCount > MAX_SECTIONS) {
+            throw ChunkException("Section count must be between 1 and " + std::to_string(MAX_SECTIONS));
+        }
+        m_sections.resize(sectionCount);
+    }
+
+    BlockId Chunk::get_block(int x, int y, int z) const noexcept {
+        if (x < 0 || x >= SECTION_SIZE || z < 0 || z >= SECTION_SIZE || y < 0 || y >= get_height()) {
+            return AIR;
+        }
+        const ChunkSection* section = m_sections[y >> 4].get();
+        return section ? section->get(x, y & 15, z) : AIR;
+    }
+
+    BlockId Chunk::set_block(int x, int y, int z, BlockId block) {
+        if (x < 0 || x >= SECTION_SIZE || z < 0 || z >= SECTION_SIZE || y < 0 || y >= get_height()) {
+            return AIR; // Out of range writes are ignored
+        }
+
+        uint32_t index = static_cast<uint32_t>(y >> 4);
+        if (!m_sections[index] && block == AIR) {
+            return AIR;
+        }
+
+        BlockId previous = get_or_create_section(index).set(x, y & 15, z, block);
+        if (previous != block) {
+            // Faces on a section boundary belong to the neighbouring section's mesh too
+            mark_dirty(index);
+            if ((y & 15) == 0 && index > 0) {
+                mark_dirty(index - 1);
+            } else if ((y & 15) == 15 && index + 1 < m_sections.size()) {
+                mark_dirty(index + 1);
+            }
+        }
+        return previous;
+    }
+
+    void Chunk::fill(BlockId block) {
+        for (uint32_t i = 0; i < m_sections.size(); ++i) {
+            if (block == AIR) {
+                m_sections[i].reset();
+            } else {
+                get_or_create_section(i).fill(block);
+            }
+            mark_dirty(i);
+        }
+    }
+
+    void Chunk::fill(int minX, int minY, int minZ, int maxX, int maxY, int maxZ, BlockId block) {
+        minY = std::max(minY, 0);
+        maxY = std::min(maxY, get_height());
+        if (minY >= maxY) {
+            return;
+        }
+
+        for (int sectionY = minY >> 4; sectionY <= (maxY - 1) >> 4; ++sectionY) {
+            uint32_t index = static_cast<uint32_t>(sectionY);
+            if (!m_sections[index] && block == AIR) {
+                continue;
+            }
+            int base = sectionY * SECTION_SIZE;
+            get_or_create_section(index).fill(minX, minY - base, minZ, maxX, maxY - base, maxZ, block);
+            mark_dirty(index);
+        }
+
+        // Neighbours of the filled range may expose new faces
+        if ((minY & 15) == 0 && (minY >> 4) > 0) {
+            mark_dirty(static_cast<uint32_t>((minY >> 4) - 1));
+        }
+        if ((maxY & 15) == 0 && static_cast<uint32_t>(maxY >> 4) < m_sections.size()) {
+            mark_dirty(static_cast<uint32_t>(maxY >> 4));
+        }
+    }
+
+    const ChunkSection* Chunk::get_section(uint32_t index) const noexcept {
+        return index < m_sections.size() ? m_sections[index].get() : nullptr;
+    }
+
+    ChunkSection& Chunk::get_or_create_section(uint32_t index) {
+        if (index >= m_sections.size()) {
+            throw ChunkException("Section index " + std::to_string(index) + " out of range");
+        }
+        if (!m_sections[index]) {
+            m_sections[index] = std::make_unique<ChunkSection>();
+        }
+        return *m_sections[index];
+    }
+
+    void Chunk::compact() {
+        for (auto& section : m_sections) {
+            if (!section) {
+                continue;
+            }
+            if (section->is_empty()) {
+                section.reset();
+            } else {
+                section->compact();
+            }
+        }
+    }
+
+    size_t Chunk::get_memory_usage() const noexcept {
+        size_t usage = sizeof(*this) + m_sections.capacity() * sizeof(m_sections[0]);
+        for (const auto& section : m_sections) {
+            if (section) {
+                usage += section->get_memory_usage();
+            }
+        }
+        return usage;
+    }
+
+    ChunkStorage::ChunkStorage(uint32_t sectionsPerChunk)
+        : m_sectionsPerChunk(sectionsPerChunk)
+    {
+        if (sectionsPerChunk == 0 || sectionsPerChunk > Chunk::MAX_SECTIONS) {
+            throw ChunkException("Section count must be between 1 and " + std::to_string(Chunk::MAX_SECTIONS));
+        }
+    }
+
+    Chunk& ChunkStorage::load_chunk(ChunkPos position) {
+        auto& chunk = m_chunks[position];
+        if (!chunk) {
+            chunk = std::make_unique<Chunk>(position, m_sectionsPerChunk);
+            mark_neighbours_dirty(position);
+        }
+        return *chunk;
+    }
+
+    bool ChunkStorage::unload_chunk(ChunkPos position) {
+        if (m_chunks.erase(position) == 0) {
+            return false;
+        }
+        mark_neighbours_dirty(position);
+        return true;
+    }
+
+    void ChunkStorage::mark_neighbours_dirty(ChunkPos position) noexcept {
+        // Their border faces were culled against (or exposed by) this column
+        constexpr std::array<ChunkPos, 4> OFFSETS{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+        for (const ChunkPos& offset : OFFSETS) {
+            Chunk* neighbour = get_chunk(ChunkPos{position.x + offset.x, position.z + offset.z});
+            if (!neighbour) {
+                continue;
+            }
+            for (uint32_t i = 0; i < neighbour->get_section_count(); ++i) {
+                if (neighbour->get_section(i)) {
+                    neighbour->mark_dirty(i);
+                }
+            }
+        }
+    }
+
+    Chunk* ChunkStorage::get_chunk(ChunkPos position) noexcept {
+        auto it = m_chunks.find(position);
+        return it != m_chunks.end() ? it->second.get() : nullptr;
+    }
+
+    const Chunk* ChunkStorage::get_chunk(ChunkPos position) const noexcept {
+        auto it = m_chunks.find(position);
+        return it != m_chunks.end() ? it->second.get() : nullptr;
+    }
+
+    BlockId ChunkStorage::get_block(int x, int y, int z) const noexcept {
+        const Chunk* chunk = get_chunk(chunk_pos_of(x, z));
+        return chunk ? chunk->get_block(x & 15, y, z & 15) : AIR;
+    }
+
+    bool ChunkStorage::set_block(int x, int y, int z, BlockId block) {
+        Chunk* chunk = get_chunk(chunk_pos_of(x, z));
+        if (!chunk) {
+            return false;
+        }
+        BlockId previous = chunk->set_block(x & 15, y, z & 15, block);
+        if (previous == block || y < 0 || y >= chunk->get_height()) {
+            return true;
+        }
+
+        // Faces on a chunk border belong to the neighbouring column's mesh too
+        uint32_t section = static_cast<uint32_t>(y >> 4);
+        auto mark_neighbour = [&](int offsetX, int offsetZ) {
+            Chunk* neighbour = get_chunk(ChunkPos{(x >> 4) + offsetX, (z >> 4) + offsetZ});
+            if (neighbour) {
+                neighbour->mark_dirty(section);
+            }
+        };
+        if ((x & 15) == 0) {
+            mark_neighbour(-1, 0);
+        } else if ((x & 15) == 15) {
+            mark_neighbour(1, 0);
+        }
+        if ((z & 15) == 0) {
+            mark_neighbour(0, -1);
+        } else if ((z & 15) == 15) {
+            mark_neighbour(0, 1);
+        }
+        return true;
+    }
+
+    void ChunkStorage::compact() {
+        for (auto& [position, chunk] : m_chunks) {
+            chunk->compact();
+        }
+    }
+
+    size_t ChunkStorage::get_memory_usage() const noexcept {
+        size_t usage = sizeof(*this);
+        for (const auto& [position, chunk] : m_chunks) {
+            usage += chunk->get_memory_usage();
+        }
+        return usage;
+    }
+
+} // namespace minecart::world
@@ -0,0 +1,484 @@
+#include "minecart/chunk_mesher.hpp"
+#include "minecart/profiler.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <span>
+
+namespace minecart::world {
+
+    namespace {
+
+        constexpr int PADDED = SectionMeshInput::PADDED_SIZE;
+
+        // 16-bit indices stop at 0xFFFE, like Model's (0xFFFF is the strip restart index)
+        constexpr size_t MAX_VERTICES_16 = 0xFFFF;
+
+        struct Direction {
+            int axis;               // 0 = x, 1 = y, 2 = z
+            bool positive;
+            graphics::VoxelFace face;
+        };
+
+        constexpr std::array<Direction, 6> DIRECTIONS{{
+            {0, true, graphics::VoxelFace::PositiveX},
+            {0, false, graphics::VoxelFace::NegativeX},
+            {1, true, graphics::VoxelFace::PositiveY},
+            {1, false, graphics::VoxelFace::NegativeY},
+            {2, true, graphics::VoxelFace::PositiveZ},
+            {2, false, graphics::VoxelFace::NegativeZ},
+        }};
+
+        // Rows of 18 bits (x = -1..16 at bits 0..17) for every padded (y, z)
+        using PaddedRows = std::array<std::array<uint32_t, PADDED>, PADDED>;
+
+        // Rows of 16 bits (x = 0..15) for every section (y, z)
+        using SectionRows = std::array<std::array<uint16_t, SECTION_SIZE>, SECTION_SIZE>;
+
+        // Block at slice coordinates: u runs along the bits of a greedy row, v across rows
+        struct SliceMapping {
+            int axis;
+            int slice;
+
+            void to_block(int u, int v, int& x, int& y, int& z) const noexcept {
+                switch (axis) {
+                    case 0: x = slice; y = v; z = u; break;
+                    case 1: x = u; y = slice; z = v; break;
+                    default: x = u; y = v; z = slice; break;
+                }
+            }
+        };
+
+        void emit_quad(SectionMesh& out, const Direction& direction, int slice, int u, int v, int width, int height, const BlockVisual& visual) {
+            // The face plane sits on the far side of the block for positive directions
+            int plane = slice + (direction.positive ? 1 : 0);
+            const std::array<std::array<int, 2>, 4> corners{{
+                {u, v}, {u + width, v}, {u + width, v + height}, {u, v + height}
+            }};
+
+            // Alternating transparent blocks can need more than 65536 vertices; switch
+            // the section to 32-bit indices rather than let them wrap
+            if (!out.is_wide() && out.vertices.size() + 4 > MAX_VERTICES_16) {
+                out.wideIndices.assign(out.indices.begin(), out.indices.end());
+                out.indices.clear();
+            }
+
+            auto base = static_cast<uint32_t>(out.vertices.size());
+            for (const auto& [cu, cv] : corners) {
+                int x, y, z;
+                SliceMapping{direction.axis, 0}.to_block(cu, cv, x, y, z);
+                switch (direction.axis) {
+                    case 0: x = plane; break;
+                    case 1: y = plane; break;
+                    default: z = plane; break;
+                }
+
+                graphics::VoxelVertex vertex;
+                vertex.position[0] = static_cast<uint16_t>(x << 8);
+                vertex.position[1] = static_cast<uint16_t>(y << 8);
+                vertex.position[2] = static_cast<uint16_t>(z << 8);
+                vertex.position[3] = static_cast<uint16_t>(direction.face);
+                std::copy(visual.color.begin(), visual.color.end(), vertex.color);
+                out.vertices.push_back(vertex);
+            }
+
+            // u x v points along -x for x faces, -y for y faces and +z for z faces;
+            // flip the winding where that disagrees with the face normal so quads are
+            // counter-clockwise seen from outside
+            bool flip = (direction.axis != 2) == direction.positive;
+            const std::array<uint32_t, 6> quad = flip
+                ? std::array<uint32_t, 6>{base, base + 2, base + 1, base, base + 3, base + 2}
+                : std::array<uint32_t, 6>{base, base + 1, base + 2, base, base + 2, base + 3};
+            if (out.is_wide()) {
+                out.wideIndices.insert(out.wideIndices.end(), quad.begin(), quad.end());
+            } else {
+                for (uint32_t index : quad) {
+                    out.indices.push_back(static_cast<uint16_t>(index));
+                }
+            }
+            out.quadCount++;
+        }
+
+    } // namespace
+
+    bool SectionMesh::upload_to(graphics::Model& model) const {
+        if (is_empty()) {
+            return false;
+        }
+        model.set_vertices(vertices);
+        if (is_wide()) {
+            model.set_indices(std::span<const uint32_t>(wideIndices));
+        } else {
+            model.set_indices(std::span<const uint16_t>(indices));
+        }
+        model.upload();
+        return true;
+    }
+
+    void ChunkMesher::mesh_section(const SectionMeshInput& input, const std::vector<BlockVisual>& visuals, SectionMesh& out) {
+        out.position = input.position;
+        out.section = input.section;
+        out.vertices.clear();
+        out.indices.clear();
+        out.wideIndices.clear();
+        out.quadCount = 0;
+
+        auto visual_of = [&](BlockId block) -> const BlockVisual& {
+            static const BlockVisual fallback{};
+            return block < visuals.size() ? visuals[block] : fallback;
+        };
+
+        // Solid and opaque bits for the padded volume, one row of 18 x bits per (y, z)
+        PaddedRows filled{};
+        PaddedRows opaque{};
+        bool anyTransparent = false;
+        for (int y = 0; y < PADDED; ++y) {
+            for (int z = 0; z < PADDED; ++z) {
+                const BlockId* row = &input.blocks[static_cast<size_t>((y * PADDED + z) * PADDED)];
+                uint32_t filledBits = 0;
+                uint32_t opaqueBits = 0;
+                for (int x = 0; x < PADDED; ++x) {
+                    if (row[x] == AIR) {
+                        continue;
+                    }
+                    filledBits |= 1u << x;
+                    if (visual_of(row[x]).opaque) {
+                        opaqueBits |= 1u << x;
+                    }
+                }
+                filled[y][z] = filledBits;
+                opaque[y][z] = opaqueBits;
+                anyTransparent |= filledBits != opaqueBits;
+            }
+        }
+
+        for (const Direction& direction : DIRECTIONS) {
+            // Offsets of the neighbouring row and the bit shift that aligns its x
+            const int dy = direction.axis == 1 ? (direction.positive ? 1 : -1) : 0;
+            const int dz = direction.axis == 2 ? (direction.positive ? 1 : -1) : 0;
+            const int shift = direction.axis == 0 ? (direction.positive ? 2 : 0) : 1;
+
+            // A face is visible when its block is solid and the neighbour is not opaque;
+            // 16 faces are tested per operation
+            SectionRows visible;
+            for (int y = 0; y < SECTION_SIZE; ++y) {
+                for (int z = 0; z < SECTION_SIZE; ++z) {
+                    uint32_t self = filled[y + 1][z + 1] >> 1;
+                    uint32_t neighbour = opaque[y + 1 + dy][z + 1 + dz] >> shift;
+                    visible[y][z] = static_cast<uint16_t>(self & ~neighbour);
+                }
+            }
+
+            // Touching transparent blocks of the same type (water, glass) hide each other
+            if (anyTransparent) {
+                const int dx = direction.axis == 0 ? (direction.positive ? 1 : -1) : 0;
+                for (int y = 0; y < SECTION_SIZE; ++y) {
+                    for (int z = 0; z < SECTION_SIZE; ++z) {
+                        uint32_t transparent = (filled[y + 1][z + 1] & ~opaque[y + 1][z + 1]) >> 1;
+                        uint32_t neighbourFilled = filled[y + 1 + dy][z + 1 + dz] >> shift;
+                        uint32_t candidates = visible[y][z] & transparent & neighbourFilled;
+                        while (candidates) {
+                            int x = std::countr_zero(candidates);
+                            candidates &= candidates - 1;
+                            if (input.get(x, y, z) == input.get(x + dx, y + dy, z + dz)) {
+                                visible[y][z] &= static_cast<uint16_t>(~(1u << x));
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Greedy merge slice by slice: grow a run of equal blocks along u, then
+            // extend it across rows while the whole run matches
+            for (int slice = 0; slice < SECTION_SIZE; ++slice) {
+                std::array<uint16_t, SECTION_SIZE> rows{};
+                switch (direction.axis) {
+                    case 0:
+                        for (int y = 0; y < SECTION_SIZE; ++y) {
+                            uint32_t row = 0;
+                            for (int z = 0; z < SECTION_SIZE; ++z) {
+                                row |= ((visible[y][z] >> slice) & 1u) << z;
+                            }
+                            rows[y] = static_cast<uint16_t>(row);
+                        }
+                        break;
+                    case 1:
+                        rows = visible[slice];
+                        break;
+                    default:
+                        for (int y = 0; y < SECTION_SIZE; ++y) {
+                            rows[y] = visible[y][slice];
+                        }
+                        break;
+                }
+
+                const SliceMapping mapping{direction.axis, slice};
+                auto block_at = [&](int u, int v) {
+                    int x, y, z;
+                    mapping.to_block(u, v, x, y, z);
+                    return input.get(x, y, z);
+                };
+
+                for (int v = 0; v < SECTION_SIZE; ++v) {
+                    while (rows[v]) {
+                        int u = std::countr_zero(rows[v]);
+                        BlockId block = block_at(u, v);
+
+                        int width = 1;
+                        while (u + width < SECTION_SIZE && ((rows[v] >> (u + width)) & 1) && block_at(u + width, v) == block) {
+                            width++;
+                        }
+                        uint32_t run = ((1u << width) - 1) << u;
+
+                        int height = 1;
+                        while (v + height < SECTION_SIZE && (rows[v + height] & run) == run) {
+                            bool same = true;
+                            for (int i = u; i < u + width && same; ++i) {
+                                same = block_at(i, v + height) == block;
+                            }
+                            if (!same) {
+                                break;
+                            }
+                            height++;
+                        }
+
+                        for (int i = v; i < v + height; ++i) {
+                            rows[i] &= static_cast<uint16_t>(~run);
+                        }
+                        emit_quad(out, direction, slice, u, v, width, height, visual_of(block));
+                    }
+                }
+            }
+        }
+    }
+
+    void ChunkMesher::gather(const ChunkStorage& storage, ChunkPos position, uint32_t section, SectionMeshInput& out) {
+        out.position = position;
+        out.section = section;
+        out.blocks.fill(AIR);
+
+        const Chunk* chunk = storage.get_chunk(position);
+        if (!chunk) {
+            return;
+        }
+
+        if (const ChunkSection* center = chunk->get_section(section)) {
+            center->for_each([&](uint32_t index, BlockId block) {
+                int x = static_cast<int>(index & 15);
+                int z = static_cast<int>((index >> 4) & 15);
+                int y = static_cast<int>(index >> 8);
+                out.blocks[SectionMeshInput::index(x, y, z)] = block;
+            });
+        }
+
+        // Layers above and below come from the neighbouring sections of this column
+        const ChunkSection* below = section > 0 ? chunk->get_section(section - 1) : nullptr;
+        const ChunkSection* above = chunk->get_section(section + 1);
+        for (int z = 0; z < SECTION_SIZE; ++z) {
+            for (int x = 0; x < SECTION_SIZE; ++x) {
+                if (below) {
+                    out.blocks[SectionMeshInput::index(x, -1, z)] = below->get(x, SECTION_SIZE - 1, z);
+                }
+                if (above) {
+                    out.blocks[SectionMeshInput::index(x, SECTION_SIZE, z)] = above->get(x, 0, z);
+                }
+            }
+        }
+
+        // Side layers come from the neighbouring chunks (air where they are not loaded)
+        const int baseY = static_cast<int>(section) * SECTION_SIZE;
+        const Chunk* negativeX = storage.get_chunk(ChunkPos{position.x - 1, position.z});
+        const Chunk* positiveX = storage.get_chunk(ChunkPos{position.x + 1, position.z});
+        const Chunk* negativeZ = storage.get_chunk(ChunkPos{position.x, position.z - 1});
+        const Chunk* positiveZ = storage.get_chunk(ChunkPos{position.x, position.z + 1});
+        for (int y = 0; y < SECTION_SIZE; ++y) {
+            for (int i = 0; i < SECTION_SIZE; ++i) {
+                if (negativeX) {
+                    out.blocks[SectionMeshInput::index(-1, y, i)] = negativeX->get_block(SECTION_SIZE - 1, baseY + y, i);
+                }
+                if (positiveX) {
+                    out.blocks[SectionMeshInput::index(SECTION_SIZE, y, i)] = positiveX->get_block(0, baseY + y, i);
+                }
+                if (negativeZ) {
+                    out.blocks[SectionMeshInput::index(i, y, -1)] = negativeZ->get_block(i, baseY + y, SECTION_SIZE - 1);
+                }
+                if (positiveZ) {
+                    out.blocks[SectionMeshInput::index(i, y, SECTION_SIZE)] = positiveZ->get_block(i, baseY + y, 0);
+                }
+            }
+        }
+    }
+
+    ChunkMesher::ChunkMesher(uint32_t threadCount)
+        : m_visuals(std::make_shared<const std::vector<BlockVisual>>())
+    {
+        if (threadCount == 0) {
+            threadCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+        }
+        m_threads.reserve(threadCount);
+        for (uint32_t i = 0; i < threadCount; ++i) {
+            m_threads.emplace_back([this] { worker(); });
+        }
+    }
+
+    ChunkMesher::ChunkMesher(JobSystem& jobSystem)
+        : m_visuals(std::make_shared<const std::vector<BlockVisual>>())
+        , m_jobSystem(&jobSystem)
+    {
+    }
+
+    ChunkMesher::~ChunkMesher() {
+        if (m_jobSystem) {
+            m_jobSystem->wait(m_counter); // Jobs hold a pointer to this mesher
+        }
+        {
+            std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+        m_jobAvailable.notify_all();
+        for (std::thread& thread : m_threads) {
+            thread.join();
+        }
+    }
+
+    void ChunkMesher::set_block_visuals(std::vector<BlockVisual> visuals) {
+        auto shared = std::make_shared<const std::vector<BlockVisual>>(std::move(visuals));
+        std::lock_guard lock(m_mutex);
+        m_visuals = std::move(shared);
+    }
+
+    void ChunkMesher::enqueue(const ChunkStorage& storage, ChunkPos position, uint32_t section) {
+        std::unique_ptr<SectionMeshInput> input;
+        {
+            std::lock_guard lock(m_mutex);
+            if (!m_freeInputs.empty()) {
+                input = std::move(m_freeInputs.back());
+                m_freeInputs.pop_back();
+            }
+        }
+        if (!input) {
+            input = std::make_unique<SectionMeshInput>();
+        }
+
+        // Copy on the calling thread so workers never read the live world
+        gather(storage, position, section, *input);
+
+        {
+            std::lock_guard lock(m_mutex);
+            m_requests.push_back(Request{std::move(input), m_visuals});
+        }
+
+        if (!m_jobSystem) {
+            m_jobAvailable.notify_one();
+            return;
+        }
+
+        // Each job meshes whichever request is oldest when it runs
+        m_jobSystem->submit([this] {
+            std::unique_ptr<SectionMesh> mesh;
+            Request request;
+            {
+                std::lock_guard lock(m_mutex);
+                request = take_request(mesh);
+            }
+            process(request, std::move(mesh));
+        }, &m_counter);
+    }
+
+    uint32_t ChunkMesher::enqueue_dirty(ChunkStorage& storage) {
+        uint32_t queued = 0;
+        storage.for_each_chunk([&](Chunk& chunk) {
+            uint64_t dirty = chunk.get_dirty_sections();
+            while (dirty) {
+                uint32_t section = static_cast<uint32_t>(std::countr_zero(dirty));
+                dirty &= dirty - 1;
+                enqueue(storage, chunk.get_position(), section);
+                queued++;
+            }
+            chunk.clear_dirty();
+        });
+        return queued;
+    }
+
+    void ChunkMesher::collect(std::vector<std::unique_ptr<SectionMesh>>& out) {
+        std::lock_guard lock(m_mutex);
+        for (auto& mesh : m_finished) {
+            out.push_back(std::move(mesh));
+        }
+        m_finished.clear();
+    }
+
+    void ChunkMesher::recycle(std::unique_ptr<SectionMesh> mesh) {
+        if (!mesh) {
+            return;
+        }
+        std::lock_guard lock(m_mutex);
+        m_freeMeshes.push_back(std::move(mesh));
+    }
+
+    void ChunkMesher::wait() {
+        if (m_jobSystem) {
+            m_jobSystem->wait(m_counter);
+            return;
+        }
+        std::unique_lock lock(m_mutex);
+        m_idle.wait(lock, [this] { return m_requests.empty() && m_active == 0; });
+    }
+
+    size_t ChunkMesher::get_pending() const {
+        std::lock_guard lock(m_mutex);
+        return m_requests.size() + m_active;
+    }
+
+    uint32_t ChunkMesher::get_thread_count() const noexcept {
+        return m_jobSystem ? m_jobSystem->get_worker_count() : static_cast<uint32_t>(m_threads.size());
+    }
+
+    ChunkMesher::Request ChunkMesher::take_request(std::unique_ptr<SectionMesh>& mesh) {
+        Request request = std::move(m_requests.front());
+        m_requests.pop_front();
+        m_active++;
+        if (!m_freeMeshes.empty()) {
+            mesh = std::move(m_freeMeshes.back());
+            m_freeMeshes.pop_back();
+        }
+        return request;
+    }
+
+    void ChunkMesher::process(Request& request, std::unique_ptr<SectionMesh> mesh) {
+        if (!mesh) {
+            mesh = std::make_unique<SectionMesh>();
+        }
+
+        {
+            MINECART_PROFILE_SCOPE("ChunkMesher::mesh_section");
+            mesh_section(*request.input, *request.visuals, *mesh);
+        }
+
+        std::lock_guard lock(m_mutex);
+        m_finished.push_back(std::move(mesh));
+        m_freeInputs.push_back(std::move(request.input));
+        m_active--;
+        if (m_requests.empty() && m_active == 0) {
+            m_idle.notify_all();
+        }
+    }
+
+    void ChunkMesher::worker() {
+        MINECART_PROFILE_THREAD("Chunk mesher");
+        for (;;) {
+            Request request;
+            std::unique_ptr<SectionMesh> mesh;
+            {
+                std::unique_lock lock(m_mutex);
+                m_jobAvailable.wait(lock, [this] { return m_stopping || !m_requests.empty(); });
+                if (m_stopping) {
+                    return; // Queued sections are dropped on shutdown
+                }
+                request = take_request(mesh);
+            }
+            process(request, std::move(mesh));
+        }
+    }
+
+} // namespace minecart::world
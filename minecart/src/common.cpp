@@ -19,9 +19,11 @@ Game::~Game() = default;
 
 int Game::run() {
     try {
+        m_jobSystem = std::make_unique<JobSystem>();
         m_window = std::make_unique<graphics::Window>(this);
         SDL_AppResult result = m_window->run();
         m_window.reset();
+        m_jobSystem.reset();
         return result == SDL_APP_SUCCESS ? 0 : 1;
     }
     catch (const graphics::WindowException& e) {
@@ -41,4 +43,11 @@ graphics::Window& Game::get_window() {
     return *m_window;
 }
 
+JobSystem& Game::get_job_system() {
+    if (!m_jobSystem) {
+        throw JobSystemException("Job system not created yet");
+    }
+    return *m_jobSystem;
+}
+
 } // namespace minecart
@@ -0,0 +1,326 @@
+#include "minecart/culling.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MINECART_CULLING_X86 1
+#include <immintrin.h>
+#endif
+
+// MSVC compiles intrinsics for any ISA; GCC and Clang need the target enabled per function
+#if defined(MINECART_CULLING_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MINECART_TARGET_SSE2 __attribute__((target("sse2")))
+#define MINECART_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MINECART_TARGET_SSE2
+#define MINECART_TARGET_AVX2
+#endif
+
+namespace minecart::graphics {
+
+    // ------------------------------------------------------------------------
+    // Frustum
+    // ------------------------------------------------------------------------
+
+    static glm::vec4 normalize_plane(const glm::vec4& plane) {
+        float length = std::sqrt(plane.x * plane.x + plane.y * plane.y + plane.z * plane.z);
+        return length > 0.0f ? plane * (1.0f / length) : plane;
+    }
+
+    Frustum Frustum::from_matrix(const glm::mat4& viewProjection, bool reverseZ) {
+        // glm is column-major: row i is (m[0][i], m[1][i], m[2][i], m[3][i])
+        const glm::mat4& m = viewProjection;
+        glm::vec4 row0{m[0][0], m[1][0], m[2][0], m[3][0]};
+        glm::vec4 row1{m[0][1], m[1][1], m[2][1], m[3][1]};
+        glm::vec4 row2{m[0][2], m[1][2], m[2][2], m[3][2]};
+        glm::vec4 row3{m[0][3], m[1][3], m[2][3], m[3][3]};
+
+        Frustum frustum;
+        frustum.planes[Left] = normalize_plane(row3 + row0);
+        frustum.planes[Right] = normalize_plane(row3 - row0);
+        frustum.planes[Bottom] = normalize_plane(row3 + row1);
+        frustum.planes[Top] = normalize_plane(row3 - row1);
+        if (reverseZ) {
+            frustum.planes[Near] = normalize_plane(row3 - row2);
+            frustum.planes[Far] = normalize_plane(row2);
+        } else {
+            frustum.planes[Near] = normalize_plane(row3 + row2);
+            frustum.planes[Far] = normalize_plane(row3 - row2);
+        }
+        return frustum;
+    }
+
+    bool Frustum::intersects(const Aabb& box) const noexcept {
+        glm::vec3 center = box.get_center();
+        glm::vec3 extents = box.get_extents();
+        for (const glm::vec4& plane : planes) {
+            float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Frustum::intersects_sphere(const glm::vec3& center, float radius) const noexcept {
+        for (const glm::vec4& plane : planes) {
+            float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+            if (distance + radius < 0.0f) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    // ------------------------------------------------------------------------
+    // CullingBounds
+    // ------------------------------------------------------------------------
+
+    uint32_t CullingBounds::add(const Aabb& box) {
+        uint32_t index = size();
+        m_centerX.push_back(0.0f);
+        m_centerY.push_back(0.0f);
+        m_centerZ.push_back(0.0f);
+        m_extentX.push_back(0.0f);
+        m_extentY.push_back(0.0f);
+        m_extentZ.push_back(0.0f);
+        m_radius.push_back(0.0f);
+        set(index, box);
+        return index;
+    }
+
+    void CullingBounds::set(uint32_t index, const Aabb& box) {
+        glm::vec3 center = box.get_center();
+        glm::vec3 extents = box.get_extents();
+        m_centerX[index] = center.x;
+        m_centerY[index] = center.y;
+        m_centerZ[index] = center.z;
+        m_extentX[index] = extents.x;
+        m_extentY[index] = extents.y;
+        m_extentZ[index] = extents.z;
+        m_radius[index] = std::sqrt(extents.x * extents.x + extents.y * extents.y + extents.z * extents.z);
+    }
+
+    void CullingBounds::clear() {
+        for (auto* array : {&m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ, &m_radius}) {
+            array->clear();
+        }
+    }
+
+    void CullingBounds::reserve(size_t count) {
+        for (auto* array : {&m_centerX, &m_centerY, &m_centerZ, &m_extentX, &m_extentY, &m_extentZ, &m_radius}) {
+            array->reserve(count);
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // Kernels
+    // ------------------------------------------------------------------------
+
+    // Each kernel tests objects [first, count) and writes visible indices to out,
+    // returning the new end of out.
+    using CullFunction = uint32_t* (*)(const Frustum&, const CullingBounds&, uint32_t first, uint32_t* out);
+
+    template<bool Spheres>
+    static uint32_t* cull_scalar(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t* out) {
+        const float* cx = bounds.center_x();
+        const float* cy = bounds.center_y();
+        const float* cz = bounds.center_z();
+        const float* ex = bounds.extent_x();
+        const float* ey = bounds.extent_y();
+        const float* ez = bounds.extent_z();
+        const float* radius = bounds.radius();
+
+        for (uint32_t i = first; i < bounds.size(); ++i) {
+            bool inside = true;
+            for (const glm::vec4& plane : frustum.planes) {
+                float distance = plane.x * cx[i] + plane.y * cy[i] + plane.z * cz[i] + plane.w;
+                float reach = Spheres
+                    ? radius[i]
+                    : std::abs(plane.x) * ex[i] + std::abs(plane.y) * ey[i] + std::abs(plane.z) * ez[i];
+                inside &= distance + reach >= 0.0f;
+            }
+            if (inside) {
+                *out++ = i;
+            }
+        }
+        return out;
+    }
+
+#ifdef MINECART_CULLING_X86
+
+    template<bool Spheres>
+    MINECART_TARGET_SSE2
+    static uint32_t* cull_sse2(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t* out) {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+        const __m128 zero = _mm_setzero_ps();
+        uint32_t count = bounds.size();
+        uint32_t i = first;
+
+        for (; i + 4 <= count; i += 4) {
+            __m128 cx = _mm_loadu_ps(bounds.center_x() + i);
+            __m128 cy = _mm_loadu_ps(bounds.center_y() + i);
+            __m128 cz = _mm_loadu_ps(bounds.center_z() + i);
+            __m128 ex = _mm_loadu_ps(bounds.extent_x() + i);
+            __m128 ey = _mm_loadu_ps(bounds.extent_y() + i);
+            __m128 ez = _mm_loadu_ps(bounds.extent_z() + i);
+            __m128 radius = _mm_loadu_ps(bounds.radius() + i);
+
+            __m128 outside = zero;
+            for (const glm::vec4& plane : frustum.planes) {
+                __m128 nx = _mm_set1_ps(plane.x);
+                __m128 ny = _mm_set1_ps(plane.y);
+                __m128 nz = _mm_set1_ps(plane.z);
+                __m128 distance = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(nx, cx), _mm_mul_ps(ny, cy)),
+                    _mm_add_ps(_mm_mul_ps(nz, cz), _mm_set1_ps(plane.w)));
+                __m128 reach = radius;
+                if constexpr (!Spheres) {
+                    reach = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(_mm_andnot_ps(signMask, nx), ex), _mm_mul_ps(_mm_andnot_ps(signMask, ny), ey)),
+                        _mm_mul_ps(_mm_andnot_ps(signMask, nz), ez));
+                }
+                outside = _mm_or_ps(outside, _mm_cmplt_ps(_mm_add_ps(distance, reach), zero));
+            }
+
+            uint32_t visibleMask = ~static_cast<uint32_t>(_mm_movemask_ps(outside)) & 0xFu;
+            while (visibleMask) {
+                *out++ = i + static_cast<uint32_t>(std::countr_zero(visibleMask));
+                visibleMask &= visibleMask - 1;
+            }
+        }
+
+        return cull_scalar<Spheres>(frustum, bounds, i, out);
+    }
+
+    template<bool Spheres>
+    MINECART_TARGET_AVX2
+    static uint32_t* cull_avx2(const Frustum& frustum, const CullingBounds& bounds, uint32_t first, uint32_t* out) {
+        const __m256 signMask = _mm256_set1_ps(-0.0f);
+        const __m256 zero = _mm256_setzero_ps();
+        uint32_t count = bounds.size();
+        uint32_t i = first;
+
+        for (; i + 8 <= count; i += 8) {
+            __m256 cx = _mm256_loadu_ps(bounds.center_x() + i);
+            __m256 cy = _mm256_loadu_ps(bounds.center_y() + i);
+            __m256 cz = _mm256_loadu_ps(bounds.center_z() + i);
+            __m256 ex = _mm256_loadu_ps(bounds.extent_x() + i);
+            __m256 ey = _mm256_loadu_ps(bounds.extent_y() + i);
+            __m256 ez = _mm256_loadu_ps(bounds.extent_z() + i);
+            __m256 radius = _mm256_loadu_ps(bounds.radius() + i);
+
+            __m256 outside = zero;
+            for (const glm::vec4& plane : frustum.planes) {
+                __m256 nx = _mm256_set1_ps(plane.x);
+                __m256 ny = _mm256_set1_ps(plane.y);
+                __m256 nz = _mm256_set1_ps(plane.z);
+                __m256 distance = _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(nx, cx), _mm256_mul_ps(ny, cy)),
+                    _mm256_add_ps(_mm256_mul_ps(nz, cz), _mm256_set1_ps(plane.w)));
+                __m256 reach = radius;
+                if constexpr (!Spheres) {
+                    reach = _mm256_add_ps(
+                        _mm256_add_ps(_mm256_mul_ps(_mm256_andnot_ps(signMask, nx), ex), _mm256_mul_ps(_mm256_andnot_ps(signMask, ny), ey)),
+                        _mm256_mul_ps(_mm256_andnot_ps(signMask, nz), ez));
+                }
+                outside = _mm256_or_ps(outside, _mm256_cmp_ps(_mm256_add_ps(distance, reach), zero, _CMP_LT_OQ));
+            }
+
+            uint32_t visibleMask = ~static_cast<uint32_t>(_mm256_movemask_ps(outside)) & 0xFFu;
+            while (visibleMask) {
+                *out++ = i + static_cast<uint32_t>(std::countr_zero(visibleMask));
+                visibleMask &= visibleMask - 1;
+            }
+        }
+
+        return cull_scalar<Spheres>(frustum, bounds, i, out);
+    }
+
+#endif // MINECART_CULLING_X86
+
+    // ------------------------------------------------------------------------
+    // Dispatch
+    // ------------------------------------------------------------------------
+
+    bool is_culling_kernel_supported(CullingKernel kernel) noexcept {
+        switch (kernel) {
+            case CullingKernel::Scalar:
+                return true;
+#ifdef MINECART_CULLING_X86
+            case CullingKernel::SSE2:
+                return SDL_HasSSE2();
+            case CullingKernel::AVX2:
+                return SDL_HasAVX2();
+#endif
+            default:
+                return false;
+        }
+    }
+
+    const char* get_culling_kernel_name(CullingKernel kernel) noexcept {
+        switch (kernel) {
+            case CullingKernel::SSE2: return "SSE2";
+            case CullingKernel::AVX2: return "AVX2";
+            default: return "Scalar";
+        }
+    }
+
+    static CullingKernel detect_culling_kernel() noexcept {
+        for (CullingKernel kernel : {CullingKernel::AVX2, CullingKernel::SSE2}) {
+            if (is_culling_kernel_supported(kernel)) {
+                return kernel;
+            }
+        }
+        return CullingKernel::Scalar;
+    }
+
+    static std::atomic<CullingKernel>& culling_kernel() noexcept {
+        static std::atomic<CullingKernel> kernel{detect_culling_kernel()};
+        return kernel;
+    }
+
+    CullingKernel get_culling_kernel() noexcept {
+        return culling_kernel().load(std::memory_order_relaxed);
+    }
+
+    void set_culling_kernel(CullingKernel kernel) noexcept {
+        culling_kernel().store(is_culling_kernel_supported(kernel) ? kernel : detect_culling_kernel(), std::memory_order_relaxed);
+    }
+
+    template<bool Spheres>
+    static CullFunction select_kernel(CullingKernel kernel) noexcept {
+        switch (kernel) {
+#ifdef MINECART_CULLING_X86
+            case CullingKernel::AVX2:
+                return &cull_avx2<Spheres>;
+            case CullingKernel::SSE2:
+                return &cull_sse2<Spheres>;
+#endif
+            default:
+                return &cull_scalar<Spheres>;
+        }
+    }
+
+    static uint32_t run_kernel(CullFunction function, const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible) {
+        visible.resize(bounds.size());
+        uint32_t* end = function(frustum, bounds, 0, visible.data());
+        visible.resize(static_cast<size_t>(end - visible.data()));
+        return static_cast<uint32_t>(visible.size());
+    }
+
+    uint32_t cull_boxes(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible) {
+        return run_kernel(select_kernel<false>(get_culling_kernel()), frustum, bounds, visible);
+    }
+
+    uint32_t cull_spheres(const Frustum& frustum, const CullingBounds& bounds, std::vector<uint32_t>& visible) {
+        return run_kernel(select_kernel<true>(get_culling_kernel()), frustum, bounds, visible);
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,175 @@
+#include "minecart/draw_list.hpp"
+#include "minecart/gpu_stats.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace minecart::graphics {
+
+    DrawList::DrawList(SDL_GPUDevice* device, UploadQueue* uploadQueue)
+        : m_device(device)
+        , m_uploadQueue(uploadQueue)
+        , m_indirectBuffer(nullptr, SDLGPUBufferDeleter{device, uploadQueue})
+    {
+        if (!device) {
+            throw DrawListException("Device cannot be null");
+        }
+    }
+
+    void DrawList::add(const Model& model, uint32_t instanceCount, uint32_t firstInstance) {
+        m_entries.push_back(Entry{&model, instanceCount, firstInstance});
+    }
+
+    void DrawList::clear() {
+        m_entries.clear();
+        m_runs.clear();
+        m_stats = DrawListStats{};
+    }
+
+    void DrawList::ensure_storage(uint32_t size) {
+        if (m_indirectBuffer && size <= m_capacity) {
+            return;
+        }
+
+        uint32_t capacity = std::max(size, m_capacity * 2);
+
+        SDL_GPUBufferCreateInfo bufferInfo{};
+        bufferInfo.usage = SDL_GPU_BUFFERUSAGE_INDIRECT;
+        bufferInfo.size = capacity;
+
+        SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+        if (!buffer) {
+            throw DrawListException(std::string("Failed to create indirect buffer: ") + SDL_GetError());
+        }
+        GpuStats::get().track_buffer(buffer, bufferInfo.size);
+        m_indirectBuffer.reset(buffer);
+        m_capacity = capacity;
+    }
+
+    void DrawList::upload() {
+        struct Draw {
+            ModelDrawInfo info;
+            uint32_t instanceCount;
+            uint32_t firstInstance;
+        };
+
+        m_stats = DrawListStats{};
+        std::vector<Draw> draws;
+        draws.reserve(m_entries.size());
+        for (const Entry& entry : m_entries) {
+            ModelDrawInfo info = entry.model->get_draw_info();
+            if (!info.vertexBuffer || info.count == 0 || entry.instanceCount == 0) {
+                m_stats.skipped++;
+                continue;
+            }
+            draws.push_back(Draw{info, entry.instanceCount, entry.firstInstance});
+        }
+
+        // Indexed draws first, then group by bindings so each group is one indirect call
+        auto bindingKey = [](const ModelDrawInfo& info) {
+            return std::make_tuple(info.indexBuffer == nullptr,
+                                   reinterpret_cast<uintptr_t>(info.vertexBuffer),
+                                   reinterpret_cast<uintptr_t>(info.indexBuffer),
+                                   info.indexElementSize);
+        };
+        std::stable_sort(draws.begin(), draws.end(), [&](const Draw& a, const Draw& b) {
+            return bindingKey(a.info) < bindingKey(b.info);
+        });
+
+        m_runs.clear();
+        m_commands.clear();
+        for (const Draw& draw : draws) {
+            const ModelDrawInfo& info = draw.info;
+            bool sameBindings = !m_runs.empty()
+                && m_runs.back().vertexBuffer == info.vertexBuffer
+                && m_runs.back().indexBuffer == info.indexBuffer
+                && m_runs.back().indexElementSize == info.indexElementSize;
+            if (!sameBindings) {
+                Run run;
+                run.vertexBuffer = info.vertexBuffer;
+                run.indexBuffer = info.indexBuffer;
+                run.indexElementSize = info.indexElementSize;
+                run.offset = static_cast<uint32_t>(m_commands.size());
+                m_runs.push_back(run);
+            }
+            m_runs.back().drawCount++;
+
+            size_t offset = m_commands.size();
+            if (info.indexBuffer) {
+                SDL_GPUIndexedIndirectDrawCommand command{};
+                command.num_indices = info.count;
+                command.num_instances = draw.instanceCount;
+                command.first_index = info.first;
+                command.vertex_offset = info.baseVertex;
+                command.first_instance = draw.firstInstance;
+                m_commands.resize(offset + sizeof(command));
+                std::memcpy(m_commands.data() + offset, &command, sizeof(command));
+            } else {
+                SDL_GPUIndirectDrawCommand command{};
+                command.num_vertices = info.count;
+                command.num_instances = draw.instanceCount;
+                command.first_vertex = info.first;
+                command.first_instance = draw.firstInstance;
+                m_commands.resize(offset + sizeof(command));
+                std::memcpy(m_commands.data() + offset, &command, sizeof(command));
+            }
+        }
+        m_stats.draws = static_cast<uint32_t>(draws.size());
+        m_stats.calls = static_cast<uint32_t>(m_runs.size());
+
+        if (m_commands.empty()) {
+            return;
+        }
+        ensure_storage(static_cast<uint32_t>(m_commands.size()));
+
+        // Every command is rewritten, so the old buffer contents can be cycled away
+        try {
+            if (m_uploadQueue) {
+                m_uploadTicket = m_uploadQueue->enqueue(m_indirectBuffer.get(), 0, std::span<const std::byte>(m_commands), true);
+            } else {
+                UploadQueue queue(m_device);
+                queue.enqueue(m_indirectBuffer.get(), 0, std::span<const std::byte>(m_commands), true);
+                queue.flush();
+                m_uploadTicket = 0;
+            }
+        }
+        catch (const UploadException& e) {
+            throw DrawListException(e.what());
+        }
+    }
+
+    void DrawList::render(SDL_GPURenderPass* renderPass) const {
+        if (!is_ready()) {
+            return; // Silently skip if not ready
+        }
+
+        for (const Run& run : m_runs) {
+            SDL_GPUBufferBinding vertexBufferBinding{};
+            vertexBufferBinding.buffer = run.vertexBuffer;
+            vertexBufferBinding.offset = 0;
+            SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+            GpuStats::get().add_buffer_binds(1);
+
+            if (run.indexBuffer) {
+                SDL_GPUBufferBinding indexBufferBinding{};
+                indexBufferBinding.buffer = run.indexBuffer;
+                indexBufferBinding.offset = 0;
+                SDL_BindGPUIndexBuffer(renderPass, &indexBufferBinding, run.indexElementSize);
+                GpuStats::get().add_buffer_binds(1);
+                SDL_DrawGPUIndexedPrimitivesIndirect(renderPass, m_indirectBuffer.get(), run.offset, run.drawCount);
+            } else {
+                SDL_DrawGPUPrimitivesIndirect(renderPass, m_indirectBuffer.get(), run.offset, run.drawCount);
+            }
+            GpuStats::get().add_indirect_draws(run.drawCount);
+        }
+    }
+
+    bool DrawList::is_ready() const noexcept {
+        if (m_uploadQueue && !m_uploadQueue->is_complete(m_uploadTicket)) {
+            return false; // Copy not recorded yet
+        }
+        return m_indirectBuffer && !m_runs.empty();
+    }
+
+} // namespace minecart::graphics
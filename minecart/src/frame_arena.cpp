@@ -0,0 +1,123 @@
+#include "minecart/frame_arena.hpp"
+#include "minecart/gpu_stats.hpp"
+
+#include <algorithm>
+#include <numeric>
+
+namespace minecart::graphics {
+
+    FrameUniformArenaBase::FrameUniformArenaBase(SDL_GPUDevice* device, UploadQueue* uploadQueue, uint32_t stride)
+        : m_device(device)
+        , m_uploadQueue(uploadQueue)
+        , m_stride(stride)
+        , m_buffer(nullptr, SDLGPUBufferDeleter{device, uploadQueue})
+        , m_indexBuffer(nullptr, SDLGPUBufferDeleter{device, uploadQueue})
+    {
+        if (!device) {
+            throw FrameArenaException("Device cannot be null");
+        }
+        if (stride == 0 || stride % 4 != 0) {
+            throw FrameArenaException("Record stride must be a non-zero multiple of 4 bytes");
+        }
+    }
+
+    void FrameUniformArenaBase::begin_frame() noexcept {
+        // Keeps the allocation, so steady-state frames don't touch the heap
+        m_data.clear();
+        m_count = 0;
+    }
+
+    uint32_t FrameUniformArenaBase::allocate_records(uint32_t count) {
+        uint32_t first = m_count;
+        m_data.resize(static_cast<size_t>(first + count) * m_stride);
+        m_count = first + count;
+        return first;
+    }
+
+    void FrameUniformArenaBase::ensure_storage() {
+        if (m_buffer && m_count <= m_capacity) {
+            return;
+        }
+
+        // Grow geometrically so a slowly rising object count doesn't recreate every frame
+        uint32_t capacity = std::max(m_count, m_capacity * 2);
+
+        SDL_GPUBufferCreateInfo bufferInfo{};
+        bufferInfo.usage = SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ;
+        bufferInfo.size = capacity * m_stride;
+        SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+        if (!buffer) {
+            throw FrameArenaException(std::string("Failed to create frame data buffer: ") + SDL_GetError());
+        }
+        GpuStats::get().track_buffer(buffer, bufferInfo.size);
+        m_buffer.reset(buffer);
+
+        SDL_GPUBufferCreateInfo indexInfo{};
+        indexInfo.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
+        indexInfo.size = capacity * static_cast<uint32_t>(sizeof(FrameDataIndex));
+        SDL_GPUBuffer* indexBuffer = SDL_CreateGPUBuffer(m_device, &indexInfo);
+        if (!indexBuffer) {
+            throw FrameArenaException(std::string("Failed to create frame data index buffer: ") + SDL_GetError());
+        }
+        GpuStats::get().track_buffer(indexBuffer, indexInfo.size);
+        m_indexBuffer.reset(indexBuffer);
+        m_capacity = capacity;
+
+        // The index stream never changes, so it is written once per buffer
+        std::vector<uint32_t> indices(capacity);
+        std::iota(indices.begin(), indices.end(), 0u);
+        enqueue(m_indexBuffer.get(), std::as_bytes(std::span<const uint32_t>(indices)), false);
+    }
+
+    void FrameUniformArenaBase::enqueue(SDL_GPUBuffer* buffer, std::span<const std::byte> data, bool cycle) {
+        try {
+            if (m_uploadQueue) {
+                m_uploadTicket = m_uploadQueue->enqueue(buffer, 0, data, cycle);
+            } else {
+                UploadQueue queue(m_device);
+                queue.enqueue(buffer, 0, data, cycle);
+                queue.flush();
+                m_uploadTicket = 0;
+            }
+        }
+        catch (const UploadException& e) {
+            throw FrameArenaException(e.what());
+        }
+    }
+
+    void FrameUniformArenaBase::upload() {
+        if (m_count == 0) {
+            return;
+        }
+        ensure_storage();
+
+        // Every live record is rewritten, so cycling is always safe
+        enqueue(m_buffer.get(), std::span<const std::byte>(m_data), true);
+        m_uploadedBytes += m_data.size();
+    }
+
+    void FrameUniformArenaBase::bind(SDL_GPURenderPass* renderPass, uint32_t storageSlot, uint32_t indexSlot) const {
+        SDL_GPUBuffer* buffer = m_buffer.get();
+        SDL_BindGPUVertexStorageBuffers(renderPass, storageSlot, &buffer, 1);
+
+        SDL_GPUBufferBinding binding{};
+        binding.buffer = m_indexBuffer.get();
+        binding.offset = 0;
+        SDL_BindGPUVertexBuffers(renderPass, indexSlot, &binding, 1);
+        GpuStats::get().add_buffer_binds(2);
+    }
+
+    void FrameUniformArenaBase::bind_fragment(SDL_GPURenderPass* renderPass, uint32_t storageSlot) const {
+        SDL_GPUBuffer* buffer = m_buffer.get();
+        SDL_BindGPUFragmentStorageBuffers(renderPass, storageSlot, &buffer, 1);
+        GpuStats::get().add_buffer_binds(1);
+    }
+
+    bool FrameUniformArenaBase::is_ready() const noexcept {
+        if (m_uploadQueue && !m_uploadQueue->is_complete(m_uploadTicket)) {
+            return false; // Copy not recorded yet
+        }
+        return m_buffer && m_count > 0;
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,178 @@
+#include "minecart/gpu_stats.hpp"
+
+#include <spdlog/spdlog.h>
+#include "imgui.h"
+
+#include <algorithm>
+#include <cfloat>
+
+namespace minecart::graphics {
+
+    GpuStats& GpuStats::get() {
+        static GpuStats stats;
+        return stats;
+    }
+
+    void GpuStats::track_buffer(const SDL_GPUBuffer* buffer, uint64_t bytes) {
+        if (!buffer) {
+            return;
+        }
+        std::lock_guard lock(m_resourceMutex);
+        if (m_bufferSizes.emplace(buffer, bytes).second) {
+            m_liveBuffers.fetch_add(1, std::memory_order_relaxed);
+            m_liveBufferBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    void GpuStats::untrack_buffer(const SDL_GPUBuffer* buffer) noexcept {
+        if (!buffer) {
+            return;
+        }
+        std::lock_guard lock(m_resourceMutex);
+        auto it = m_bufferSizes.find(buffer);
+        if (it == m_bufferSizes.end()) {
+            return;
+        }
+        m_liveBuffers.fetch_sub(1, std::memory_order_relaxed);
+        m_liveBufferBytes.fetch_sub(it->second, std::memory_order_relaxed);
+        m_bufferSizes.erase(it);
+    }
+
+    void GpuStats::track_shader(const SDL_GPUShader* shader, uint64_t bytes) {
+        if (!shader) {
+            return;
+        }
+        std::lock_guard lock(m_resourceMutex);
+        if (m_shaderSizes.emplace(shader, bytes).second) {
+            m_liveShaders.fetch_add(1, std::memory_order_relaxed);
+            m_liveShaderBytes.fetch_add(bytes, std::memory_order_relaxed);
+        }
+    }
+
+    void GpuStats::untrack_shader(const SDL_GPUShader* shader) noexcept {
+        if (!shader) {
+            return;
+        }
+        std::lock_guard lock(m_resourceMutex);
+        auto it = m_shaderSizes.find(shader);
+        if (it == m_shaderSizes.end()) {
+            return;
+        }
+        m_liveShaders.fetch_sub(1, std::memory_order_relaxed);
+        m_liveShaderBytes.fetch_sub(it->second, std::memory_order_relaxed);
+        m_shaderSizes.erase(it);
+    }
+
+    void GpuStats::end_frame() {
+        GpuFrameStats stats;
+        stats.frame = m_frame++;
+        stats.drawCalls = m_drawCalls.exchange(0, std::memory_order_relaxed);
+        stats.primitives = m_primitives.exchange(0, std::memory_order_relaxed);
+        stats.pipelineBinds = m_pipelineBinds.exchange(0, std::memory_order_relaxed);
+        stats.bufferBinds = m_bufferBinds.exchange(0, std::memory_order_relaxed);
+        stats.uniformPushes = m_uniformPushes.exchange(0, std::memory_order_relaxed);
+        stats.uniformBytes = m_uniformBytes.exchange(0, std::memory_order_relaxed);
+        stats.bytesUploaded = m_bytesUploaded.exchange(0, std::memory_order_relaxed);
+        stats.transferBuffersCreated = m_transferBuffersCreated.exchange(0, std::memory_order_relaxed);
+        stats.liveBuffers = m_liveBuffers.load(std::memory_order_relaxed);
+        stats.liveBufferBytes = m_liveBufferBytes.load(std::memory_order_relaxed);
+        stats.liveShaders = m_liveShaders.load(std::memory_order_relaxed);
+        stats.liveShaderBytes = m_liveShaderBytes.load(std::memory_order_relaxed);
+
+        m_lastFrame = stats;
+        m_history[stats.frame % HISTORY] = stats;
+
+        if (m_logInterval > 0 && stats.frame % m_logInterval == 0) {
+            spdlog::info("GPU stats [frame {}]: {} draws, {} primitives, {} pipeline binds, {} buffer binds, "
+                "{} uniform pushes ({} B), {} B uploaded, {} transfer buffers, {} buffers ({} B), {} shaders ({} B)",
+                stats.frame, stats.drawCalls, stats.primitives, stats.pipelineBinds, stats.bufferBinds,
+                stats.uniformPushes, stats.uniformBytes, stats.bytesUploaded, stats.transferBuffersCreated,
+                stats.liveBuffers, stats.liveBufferBytes, stats.liveShaders, stats.liveShaderBytes);
+        }
+
+        if (m_csv.is_open()) {
+            m_csv << stats.frame << ',' << stats.drawCalls << ',' << stats.primitives << ','
+                  << stats.pipelineBinds << ',' << stats.bufferBinds << ',' << stats.uniformPushes << ','
+                  << stats.uniformBytes << ',' << stats.bytesUploaded << ',' << stats.transferBuffersCreated << ','
+                  << stats.liveBuffers << ',' << stats.liveBufferBytes << ','
+                  << stats.liveShaders << ',' << stats.liveShaderBytes << '\n';
+        }
+    }
+
+    void GpuStats::start_csv(const std::string& path) {
+        stop_csv();
+        m_csv.open(path, std::ios::trunc);
+        if (!m_csv.is_open()) {
+            throw GpuStatsException("Failed to open CSV file: " + path);
+        }
+        m_csv << "frame,draw_calls,primitives,pipeline_binds,buffer_binds,uniform_pushes,uniform_bytes,"
+                 "bytes_uploaded,transfer_buffers_created,live_buffers,live_buffer_bytes,live_shaders,live_shader_bytes\n";
+    }
+
+    void GpuStats::stop_csv() {
+        if (m_csv.is_open()) {
+            m_csv.close();
+        }
+    }
+
+    void GpuStats::draw_panel() {
+        if (!m_panelVisible) {
+            return;
+        }
+
+        if (!ImGui::Begin("GPU Stats", &m_panelVisible)) {
+            ImGui::End();
+            return;
+        }
+
+        // Draw calls over the recorded history, oldest first
+        std::array<float, HISTORY> drawCalls{};
+        int count = 0;
+        const uint64_t available = std::min<uint64_t>(m_frame, HISTORY);
+        for (uint64_t frame = m_frame - available; frame < m_frame; ++frame) {
+            drawCalls[count++] = static_cast<float>(m_history[frame % HISTORY].drawCalls);
+        }
+        ImGui::PlotLines("Draw calls", drawCalls.data(), count, 0, nullptr, 0.0f, FLT_MAX, ImVec2(0.0f, 60.0f));
+
+        const GpuFrameStats& stats = m_lastFrame;
+        if (ImGui::BeginTable("GpuStats", 2, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+            auto row = [](const char* name, uint64_t value) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%llu", static_cast<unsigned long long>(value));
+            };
+            row("Draw calls", stats.drawCalls);
+            row("Primitives", stats.primitives);
+            row("Pipeline binds", stats.pipelineBinds);
+            row("Buffer binds", stats.bufferBinds);
+            row("Uniform pushes", stats.uniformPushes);
+            row("Uniform bytes", stats.uniformBytes);
+            row("Bytes uploaded", stats.bytesUploaded);
+            row("Transfer buffers created", stats.transferBuffersCreated);
+            row("Live buffers", stats.liveBuffers);
+            row("Live buffer bytes", stats.liveBufferBytes);
+            row("Live shaders", stats.liveShaders);
+            row("Live shader bytes", stats.liveShaderBytes);
+            ImGui::EndTable();
+        }
+
+        bool recording = is_recording_csv();
+        if (ImGui::Checkbox("Record CSV (gpu_stats.csv)", &recording)) {
+            try {
+                if (recording) {
+                    start_csv("gpu_stats.csv");
+                } else {
+                    stop_csv();
+                }
+            }
+            catch (const GpuStatsException& e) {
+                spdlog::error("{}", e.what());
+            }
+        }
+
+        ImGui::End();
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,123 @@
+#include "minecart/instance_buffer.hpp"
+#include "minecart/gpu_stats.hpp"
+
+#include <algorithm>
+
+namespace minecart::graphics {
+
+    InstanceBufferBase::InstanceBufferBase(SDL_GPUDevice* device, UploadQueue* uploadQueue, uint32_t stride, InstanceBufferUsage usage)
+        : m_device(device)
+        , m_uploadQueue(uploadQueue)
+        , m_stride(stride)
+        , m_usage(usage)
+        , m_buffer(nullptr, SDLGPUBufferDeleter{device, uploadQueue})
+    {
+        if (!device) {
+            throw InstanceBufferException("Device cannot be null");
+        }
+        if (stride == 0) {
+            throw InstanceBufferException("Instance stride cannot be zero");
+        }
+        if (usage == InstanceBufferUsage::Storage && stride % 4 != 0) {
+            throw InstanceBufferException("Storage buffer instances must be a multiple of 4 bytes");
+        }
+    }
+
+    void InstanceBufferBase::mark_dirty(uint32_t first, uint32_t count) noexcept {
+        if (m_dirtyBegin >= m_dirtyEnd) {
+            m_dirtyBegin = first;
+            m_dirtyEnd = first + count;
+            return;
+        }
+        m_dirtyBegin = std::min(m_dirtyBegin, first);
+        m_dirtyEnd = std::max(m_dirtyEnd, first + count);
+    }
+
+    void InstanceBufferBase::resize_records(uint32_t count) {
+        m_data.resize(static_cast<size_t>(count) * m_stride);
+        m_count = count;
+        m_uploadedCount = std::min(m_uploadedCount, count);
+        m_dirtyEnd = std::min(m_dirtyEnd, count);
+    }
+
+    void InstanceBufferBase::ensure_storage() {
+        if (m_buffer && m_count <= m_capacity) {
+            return;
+        }
+
+        // Grow geometrically so adding instances one at a time stays cheap
+        uint32_t capacity = std::max(m_count, m_capacity * 2);
+
+        SDL_GPUBufferCreateInfo bufferInfo{};
+        bufferInfo.usage = m_usage == InstanceBufferUsage::Storage
+            ? SDL_GPU_BUFFERUSAGE_GRAPHICS_STORAGE_READ
+            : SDL_GPU_BUFFERUSAGE_VERTEX;
+        bufferInfo.size = capacity * m_stride;
+
+        SDL_GPUBuffer* buffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+        if (!buffer) {
+            throw InstanceBufferException(std::string("Failed to create instance buffer: ") + SDL_GetError());
+        }
+        GpuStats::get().track_buffer(buffer, bufferInfo.size);
+        m_buffer.reset(buffer);
+        m_capacity = capacity;
+
+        // The new buffer holds nothing yet
+        m_dirtyBegin = 0;
+        m_dirtyEnd = m_count;
+    }
+
+    void InstanceBufferBase::upload() {
+        if (m_count == 0 || m_dirtyBegin >= m_dirtyEnd) {
+            return;
+        }
+        ensure_storage();
+
+        // Cycling is only safe when every live instance is rewritten
+        bool wholeBuffer = m_dirtyBegin == 0 && m_dirtyEnd == m_count;
+        auto data = std::span<const std::byte>(m_data).subspan(
+            static_cast<size_t>(m_dirtyBegin) * m_stride,
+            static_cast<size_t>(m_dirtyEnd - m_dirtyBegin) * m_stride);
+
+        try {
+            if (m_uploadQueue) {
+                m_uploadTicket = m_uploadQueue->enqueue(m_buffer.get(), m_dirtyBegin * m_stride, data, wholeBuffer);
+            } else {
+                UploadQueue queue(m_device);
+                queue.enqueue(m_buffer.get(), m_dirtyBegin * m_stride, data, wholeBuffer);
+                queue.flush();
+                m_uploadTicket = 0;
+            }
+        }
+        catch (const UploadException& e) {
+            throw InstanceBufferException(e.what());
+        }
+
+        m_uploadedBytes += data.size_bytes();
+        m_uploadedCount = m_count;
+        m_dirtyBegin = 0;
+        m_dirtyEnd = 0;
+    }
+
+    void InstanceBufferBase::bind(SDL_GPURenderPass* renderPass, uint32_t slot) const {
+        SDL_GPUBuffer* buffer = m_buffer.get();
+        GpuStats::get().add_buffer_binds(1);
+        if (m_usage == InstanceBufferUsage::Storage) {
+            SDL_BindGPUVertexStorageBuffers(renderPass, slot, &buffer, 1);
+            return;
+        }
+
+        SDL_GPUBufferBinding binding{};
+        binding.buffer = buffer;
+        binding.offset = 0;
+        SDL_BindGPUVertexBuffers(renderPass, slot, &binding, 1);
+    }
+
+    bool InstanceBufferBase::is_ready() const noexcept {
+        if (m_uploadQueue && !m_uploadQueue->is_complete(m_uploadTicket)) {
+            return false; // Copy not recorded yet
+        }
+        return m_buffer && m_uploadedCount > 0;
+    }
+
+} // namespace minecart::graphics
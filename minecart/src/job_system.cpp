@@ -0,0 +1,248 @@
+#include "minecart/job_system.hpp"
+#include "minecart/profiler.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+
+namespace minecart {
+
+    namespace {
+
+        // Which job system (if any) owns the current thread, and its queue index
+        thread_local const JobSystem* t_jobSystem = nullptr;
+        thread_local uint32_t t_workerIndex = 0;
+
+    } // namespace
+
+    JobSystem::JobSystem(uint32_t workerCount)
+        : m_mainThread(std::this_thread::get_id())
+    {
+        if (workerCount == 0) {
+            workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+        }
+
+        m_queues.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            m_queues.push_back(std::make_unique<WorkerQueue>());
+        }
+        m_workers.reserve(workerCount);
+        for (uint32_t i = 0; i < workerCount; ++i) {
+            m_workers.emplace_back([this, i] { worker(i); });
+        }
+    }
+
+    JobSystem::~JobSystem() {
+        {
+            std::lock_guard lock(m_sleepMutex);
+            m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& thread : m_workers) {
+            thread.join();
+        }
+    }
+
+    void JobSystem::submit(Job job, JobCounter* counter) {
+        if (counter) {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        schedule(Task{std::move(job), counter}, false);
+    }
+
+    void JobSystem::submit_main(Job job, JobCounter* counter) {
+        if (counter) {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+        schedule(Task{std::move(job), counter}, true);
+    }
+
+    void JobSystem::submit_after(JobCounter& dependency, Job job, JobCounter* counter) {
+        add_dependency(dependency, std::move(job), counter, false);
+    }
+
+    void JobSystem::submit_main_after(JobCounter& dependency, Job job, JobCounter* counter) {
+        add_dependency(dependency, std::move(job), counter, true);
+    }
+
+    void JobSystem::add_dependency(JobCounter& dependency, Job job, JobCounter* counter, bool mainThread) {
+        if (counter) {
+            counter->m_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        {
+            // finish() takes the same lock before releasing continuations, so the job
+            // is either stored before the count drops to zero or scheduled here
+            std::lock_guard lock(dependency.m_mutex);
+            if (!dependency.is_done()) {
+                dependency.m_continuations.push_back(JobCounter::Continuation{std::move(job), counter, mainThread});
+                return;
+            }
+        }
+        schedule(Task{std::move(job), counter}, mainThread);
+    }
+
+    void JobSystem::schedule(Task task, bool mainThread) {
+        if (mainThread) {
+            std::lock_guard lock(m_mainMutex);
+            m_mainTasks.push_back(std::move(task));
+            return;
+        }
+
+        // Workers push onto their own deque; everyone else spreads jobs round robin
+        uint32_t index = t_jobSystem == this
+            ? t_workerIndex
+            : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % static_cast<uint32_t>(m_queues.size());
+        {
+            std::lock_guard lock(m_queues[index]->mutex);
+            m_queues[index]->tasks.push_back(std::move(task));
+        }
+        {
+            std::lock_guard lock(m_sleepMutex);
+            m_queuedTasks.fetch_add(1, std::memory_order_release);
+        }
+        m_wake.notify_one();
+    }
+
+    bool JobSystem::try_run_one(uint32_t preferredQueue) {
+        const uint32_t queueCount = static_cast<uint32_t>(m_queues.size());
+        Task task;
+        bool found = false;
+
+        // Newest job from our own deque first, then the oldest job of the others
+        for (uint32_t i = 0; i < queueCount && !found; ++i) {
+            WorkerQueue& queue = *m_queues[(preferredQueue + i) % queueCount];
+            std::lock_guard lock(queue.mutex);
+            if (queue.tasks.empty()) {
+                continue;
+            }
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            found = true;
+        }
+        if (!found) {
+            return false;
+        }
+
+        m_queuedTasks.fetch_sub(1, std::memory_order_relaxed);
+        execute(task);
+        return true;
+    }
+
+    void JobSystem::execute(Task& task) {
+        try {
+            MINECART_PROFILE_SCOPE("Job");
+            task.job();
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Job Error: {}", e.what());
+        }
+        finish(task.counter);
+    }
+
+    void JobSystem::finish(JobCounter* counter) {
+        if (!counter) {
+            return;
+        }
+
+        // Decrement under the lock: wait() takes it once more after seeing zero, so the
+        // counter is not destroyed while this thread still touches it
+        std::vector<JobCounter::Continuation> continuations;
+        {
+            std::lock_guard lock(counter->m_mutex);
+            if (counter->m_pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+                return;
+            }
+            continuations.swap(counter->m_continuations);
+        }
+        for (JobCounter::Continuation& continuation : continuations) {
+            schedule(Task{std::move(continuation.job), continuation.counter}, continuation.mainThread);
+        }
+    }
+
+    void JobSystem::wait(JobCounter& counter) {
+        const bool mainThread = is_main_thread();
+        const uint32_t preferredQueue = t_jobSystem == this ? t_workerIndex : 0;
+        while (!counter.is_done()) {
+            if (mainThread && run_main_thread_jobs() > 0) {
+                continue;
+            }
+            if (!try_run_one(preferredQueue)) {
+                std::this_thread::yield();
+            }
+        }
+
+        // Synchronise with the finishing job releasing the counter's lock
+        std::lock_guard lock(counter.m_mutex);
+    }
+
+    uint32_t JobSystem::grain_for(uint32_t count, uint32_t grain) const noexcept {
+        if (grain > 0) {
+            return grain;
+        }
+        // Roughly four ranges per worker leaves room for stealing to even out the load
+        uint32_t ranges = std::max(1u, get_worker_count() * 4);
+        return std::max(1u, (count + ranges - 1) / ranges);
+    }
+
+    void JobSystem::parallel_for(uint32_t count, uint32_t grain, const std::function<void(uint32_t, uint32_t)>& function) {
+        JobCounter counter;
+        grain = grain_for(count, grain);
+        for (uint32_t begin = 0; begin < count; begin += grain) {
+            uint32_t end = std::min(count, begin + grain);
+            submit([&function, begin, end] { function(begin, end); }, &counter);
+        }
+        wait(counter);
+    }
+
+    void JobSystem::parallel_for(uint32_t count, uint32_t grain, std::function<void(uint32_t, uint32_t)> function, JobCounter& counter) {
+        auto shared = std::make_shared<std::function<void(uint32_t, uint32_t)>>(std::move(function));
+        grain = grain_for(count, grain);
+        for (uint32_t begin = 0; begin < count; begin += grain) {
+            uint32_t end = std::min(count, begin + grain);
+            submit([shared, begin, end] { (*shared)(begin, end); }, &counter);
+        }
+    }
+
+    uint32_t JobSystem::run_main_thread_jobs() {
+        if (!is_main_thread()) {
+            throw JobSystemException("Main-thread jobs can only run on the main thread");
+        }
+
+        std::deque<Task> tasks;
+        {
+            std::lock_guard lock(m_mainMutex);
+            tasks.swap(m_mainTasks);
+        }
+        for (Task& task : tasks) {
+            execute(task);
+        }
+        return static_cast<uint32_t>(tasks.size());
+    }
+
+    void JobSystem::worker(uint32_t index) {
+        t_jobSystem = this;
+        t_workerIndex = index;
+        MINECART_PROFILE_THREAD("Worker " + std::to_string(index));
+
+        for (;;) {
+            if (try_run_one(index)) {
+                continue;
+            }
+
+            std::unique_lock lock(m_sleepMutex);
+            m_wake.wait(lock, [this] {
+                return m_stopping || m_queuedTasks.load(std::memory_order_acquire) > 0;
+            });
+            if (m_stopping) {
+                return;
+            }
+        }
+    }
+
+} // namespace minecart
@@ -0,0 +1,483 @@
+#include "minecart/mesh_optimizer.hpp"
+#include "minecart/hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+
+namespace minecart::graphics {
+
+    static constexpr uint32_t INVALID_INDEX = ~0u;
+
+    // ------------------------------------------------------------------------
+    // Vertex deduplication
+    // ------------------------------------------------------------------------
+
+    // Hashes and compares vertices by their bytes, referenced by index into the source data
+    struct VertexBytesHasher {
+        const std::byte* data;
+        uint32_t stride;
+
+        size_t operator()(uint32_t index) const noexcept {
+            return static_cast<size_t>(fnv1a(data + static_cast<size_t>(index) * stride, stride));
+        }
+
+        bool operator()(uint32_t a, uint32_t b) const noexcept {
+            return std::memcmp(data + static_cast<size_t>(a) * stride, data + static_cast<size_t>(b) * stride, stride) == 0;
+        }
+    };
+
+    uint32_t MeshOptimizer::generate_vertex_remap(std::span<const std::byte> vertices, uint32_t stride, std::vector<uint32_t>& remap) {
+        uint32_t vertexCount = static_cast<uint32_t>(vertices.size() / stride);
+        remap.assign(vertexCount, INVALID_INDEX);
+
+        VertexBytesHasher hasher{vertices.data(), stride};
+        std::unordered_map<uint32_t, uint32_t, VertexBytesHasher, VertexBytesHasher> unique(vertexCount, hasher, hasher);
+
+        uint32_t uniqueCount = 0;
+        for (uint32_t i = 0; i < vertexCount; ++i) {
+            auto [it, inserted] = unique.try_emplace(i, uniqueCount);
+            if (inserted) {
+                uniqueCount++;
+            }
+            remap[i] = it->second;
+        }
+        return uniqueCount;
+    }
+
+    // Compact vertices so old vertex i lands at remap[i]
+    static void remap_vertices(std::vector<std::byte>& vertices, uint32_t stride, std::span<const uint32_t> remap, uint32_t newCount) {
+        std::vector<std::byte> remapped(static_cast<size_t>(newCount) * stride);
+        for (uint32_t i = 0; i < remap.size(); ++i) {
+            if (remap[i] != INVALID_INDEX) {
+                std::memcpy(remapped.data() + static_cast<size_t>(remap[i]) * stride,
+                            vertices.data() + static_cast<size_t>(i) * stride, stride);
+            }
+        }
+        vertices = std::move(remapped);
+    }
+
+    // ------------------------------------------------------------------------
+    // Vertex cache optimisation (Tom Forsyth, "Linear-Speed Vertex Cache Optimisation")
+    // ------------------------------------------------------------------------
+
+    static constexpr float CACHE_DECAY_POWER = 1.5f;
+    static constexpr float LAST_TRIANGLE_SCORE = 0.75f;
+    static constexpr float VALENCE_BOOST_SCALE = 2.0f;
+    static constexpr float VALENCE_BOOST_POWER = 0.5f;
+
+    static float vertex_score(int32_t cachePosition, uint32_t activeTriangles, uint32_t cacheSize) {
+        if (activeTriangles == 0) {
+            return -1.0f; // No triangles left to use this vertex
+        }
+
+        float score = 0.0f;
+        if (cachePosition >= 0) {
+            if (cachePosition < 3) {
+                // Used by the last triangle; fixed score so triangles sharing an edge aren't over-favoured
+                score = LAST_TRIANGLE_SCORE;
+            } else {
+                float scaler = 1.0f / static_cast<float>(cacheSize - 3);
+                score = std::pow(1.0f - static_cast<float>(cachePosition - 3) * scaler, CACHE_DECAY_POWER);
+            }
+        }
+
+        // Favour vertices with few triangles left so lone triangles don't get stranded
+        score += VALENCE_BOOST_SCALE * std::pow(static_cast<float>(activeTriangles), -VALENCE_BOOST_POWER);
+        return score;
+    }
+
+    void MeshOptimizer::optimize_vertex_cache(std::span<uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize) {
+        uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        if (triangleCount == 0) {
+            return;
+        }
+        cacheSize = std::max(cacheSize, 4u);
+
+        // Per-vertex triangle adjacency (CSR); activeCount shrinks as triangles are emitted
+        std::vector<uint32_t> activeCount(vertexCount, 0);
+        for (uint32_t i = 0; i < triangleCount * 3; ++i) {
+            if (indices[i] >= vertexCount) {
+                throw MeshOptimizerException("Index references a vertex past the end of the mesh");
+            }
+            activeCount[indices[i]]++;
+        }
+        std::vector<uint32_t> adjacencyOffset(vertexCount + 1, 0);
+        std::inclusive_scan(activeCount.begin(), activeCount.end(), adjacencyOffset.begin() + 1);
+        std::vector<uint32_t> adjacency(triangleCount * 3);
+        {
+            std::vector<uint32_t> fill(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+            for (uint32_t t = 0; t < triangleCount; ++t) {
+                for (uint32_t k = 0; k < 3; ++k) {
+                    adjacency[fill[indices[t * 3 + k]]++] = t;
+                }
+            }
+        }
+
+        std::vector<int32_t> cachePosition(vertexCount, -1);
+        std::vector<float> vertexScores(vertexCount);
+        for (uint32_t v = 0; v < vertexCount; ++v) {
+            vertexScores[v] = vertex_score(-1, activeCount[v], cacheSize);
+        }
+
+        std::vector<float> triangleScores(triangleCount);
+        std::vector<bool> emitted(triangleCount, false);
+        uint32_t bestTriangle = 0;
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            triangleScores[t] = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+            if (triangleScores[t] > triangleScores[bestTriangle]) {
+                bestTriangle = t;
+            }
+        }
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        std::vector<uint32_t> cache;
+        std::vector<uint32_t> nextCache;
+        cache.reserve(cacheSize + 3);
+        nextCache.reserve(cacheSize + 3);
+        uint32_t scanCursor = 0;
+
+        while (bestTriangle != INVALID_INDEX) {
+            const uint32_t triangle[3] = {indices[bestTriangle * 3], indices[bestTriangle * 3 + 1], indices[bestTriangle * 3 + 2]};
+            output.insert(output.end(), triangle, triangle + 3);
+            emitted[bestTriangle] = true;
+
+            // Remove the triangle from its vertices' active lists
+            for (uint32_t v : triangle) {
+                uint32_t* first = adjacency.data() + adjacencyOffset[v];
+                uint32_t* last = first + activeCount[v];
+                uint32_t* found = std::find(first, last, bestTriangle);
+                if (found != last) {
+                    *found = *(last - 1);
+                    activeCount[v]--;
+                }
+            }
+
+            // New cache order: this triangle's vertices first, then the old contents
+            nextCache.clear();
+            for (uint32_t v : triangle) {
+                if (std::find(nextCache.begin(), nextCache.end(), v) == nextCache.end()) {
+                    nextCache.push_back(v); // Degenerate triangles repeat a vertex
+                }
+            }
+            for (uint32_t v : cache) {
+                if (v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+                    nextCache.push_back(v);
+                }
+            }
+            for (size_t i = cacheSize; i < nextCache.size(); ++i) {
+                cachePosition[nextCache[i]] = -1;
+                vertexScores[nextCache[i]] = vertex_score(-1, activeCount[nextCache[i]], cacheSize);
+            }
+            if (nextCache.size() > cacheSize) {
+                nextCache.resize(cacheSize);
+            }
+            std::swap(cache, nextCache);
+
+            for (uint32_t i = 0; i < cache.size(); ++i) {
+                cachePosition[cache[i]] = static_cast<int32_t>(i);
+                vertexScores[cache[i]] = vertex_score(static_cast<int32_t>(i), activeCount[cache[i]], cacheSize);
+            }
+
+            // Only triangles touching the cache changed score; pick the best of them
+            bestTriangle = INVALID_INDEX;
+            float bestScore = -1.0f;
+            for (uint32_t v : cache) {
+                for (uint32_t i = 0; i < activeCount[v]; ++i) {
+                    uint32_t t = adjacency[adjacencyOffset[v] + i];
+                    float score = vertexScores[indices[t * 3]] + vertexScores[indices[t * 3 + 1]] + vertexScores[indices[t * 3 + 2]];
+                    triangleScores[t] = score;
+                    if (score > bestScore) {
+                        bestScore = score;
+                        bestTriangle = t;
+                    }
+                }
+            }
+
+            // Nothing adjacent to the cache: continue with the next unemitted triangle
+            if (bestTriangle == INVALID_INDEX) {
+                while (scanCursor < triangleCount && emitted[scanCursor]) {
+                    scanCursor++;
+                }
+                if (scanCursor < triangleCount) {
+                    bestTriangle = scanCursor;
+                }
+            }
+        }
+
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    // ------------------------------------------------------------------------
+    // Overdraw optimisation (Sander et al., "Fast Triangle Reordering for Vertex
+    // Locality and Reduced Overdraw")
+    // ------------------------------------------------------------------------
+
+    // FIFO cache simulation shared by the clustering passes. Bumping `time` past
+    // cacheSize empties the cache.
+    struct CacheSimulator {
+        std::vector<uint32_t> timestamp;
+        uint32_t cacheSize;
+        uint32_t time;
+
+        CacheSimulator(uint32_t vertexCount, uint32_t cacheSize)
+            : timestamp(vertexCount, 0), cacheSize(cacheSize), time(cacheSize + 1) {}
+
+        void reset() noexcept { time += cacheSize + 1; }
+
+        // Cache misses caused by one triangle
+        uint32_t triangle_misses(const uint32_t* triangle) noexcept {
+            uint32_t misses = 0;
+            for (uint32_t k = 0; k < 3; ++k) {
+                if (time - timestamp[triangle[k]] > cacheSize) {
+                    timestamp[triangle[k]] = time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+    };
+
+    void MeshOptimizer::optimize_overdraw(std::span<uint32_t> indices, std::span<const std::array<float, 3>> positions,
+                                          uint32_t cacheSize, float threshold) {
+        uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        uint32_t vertexCount = static_cast<uint32_t>(positions.size());
+        if (triangleCount == 0) {
+            return;
+        }
+        if (std::any_of(indices.begin(), indices.begin() + triangleCount * 3, [&](uint32_t index) { return index >= vertexCount; })) {
+            throw MeshOptimizerException("Index references a vertex without a position");
+        }
+        cacheSize = std::max(cacheSize, 4u);
+        threshold = std::max(threshold, 1.0f);
+
+        // Hard boundaries: a triangle missing on all three vertices usually starts a
+        // patch that is disjoint from the previous one
+        CacheSimulator cache(vertexCount, cacheSize);
+        std::vector<uint32_t> hardBoundaries;
+        for (uint32_t t = 0; t < triangleCount; ++t) {
+            if (cache.triangle_misses(&indices[t * 3]) == 3 || t == 0) {
+                hardBoundaries.push_back(t);
+            }
+        }
+
+        // Soft boundaries: cut each patch wherever the running ACMR since the last cut
+        // gets within threshold of the patch's own ACMR, starting with an empty cache
+        std::vector<uint32_t> clusters;
+        for (size_t i = 0; i < hardBoundaries.size(); ++i) {
+            uint32_t start = hardBoundaries[i];
+            uint32_t end = i + 1 < hardBoundaries.size() ? hardBoundaries[i + 1] : triangleCount;
+
+            cache.reset();
+            uint32_t patchMisses = 0;
+            for (uint32_t t = start; t < end; ++t) {
+                patchMisses += cache.triangle_misses(&indices[t * 3]);
+            }
+            float targetAcmr = threshold * static_cast<float>(patchMisses) / static_cast<float>(end - start);
+
+            clusters.push_back(start);
+            cache.reset();
+            uint32_t runningMisses = 0;
+            uint32_t runningTriangles = 0;
+            for (uint32_t t = start; t < end; ++t) {
+                runningMisses += cache.triangle_misses(&indices[t * 3]);
+                runningTriangles++;
+                if (static_cast<float>(runningMisses) <= targetAcmr * static_cast<float>(runningTriangles)) {
+                    clusters.push_back(t + 1);
+                    cache.reset();
+                    runningMisses = 0;
+                    runningTriangles = 0;
+                }
+            }
+
+            // The tail after the last cut is usually too short to have a good ACMR of
+            // its own, so merge it into the cluster before (this also drops a cut at end)
+            if (clusters.back() != start) {
+                clusters.pop_back();
+            }
+        }
+        uint32_t clusterCount = static_cast<uint32_t>(clusters.size());
+        clusters.push_back(triangleCount);
+
+        // Centroid of everything drawn, weighted by how often each vertex is referenced
+        std::array<double, 3> meshCentroid{};
+        for (uint32_t index : indices.first(triangleCount * 3)) {
+            for (uint32_t k = 0; k < 3; ++k) {
+                meshCentroid[k] += positions[index][k];
+            }
+        }
+        for (double& component : meshCentroid) {
+            component /= static_cast<double>(triangleCount * 3);
+        }
+
+        // Sort key: how far the cluster's area-weighted centroid lies along its average
+        // normal from the mesh centroid. Clusters facing out from the outside of the mesh
+        // tend to occlude the rest, so they are drawn first.
+        std::vector<float> sortKeys(clusterCount);
+        for (uint32_t c = 0; c < clusterCount; ++c) {
+            std::array<float, 3> centroid{};
+            std::array<float, 3> normal{};
+            float area = 0.0f;
+            for (uint32_t t = clusters[c]; t < clusters[c + 1]; ++t) {
+                const std::array<float, 3>& p0 = positions[indices[t * 3]];
+                const std::array<float, 3>& p1 = positions[indices[t * 3 + 1]];
+                const std::array<float, 3>& p2 = positions[indices[t * 3 + 2]];
+                std::array<float, 3> e1{p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+                std::array<float, 3> e2{p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+                std::array<float, 3> cross{e1[1] * e2[2] - e1[2] * e2[1], e1[2] * e2[0] - e1[0] * e2[2], e1[0] * e2[1] - e1[1] * e2[0]};
+                float triangleArea = std::sqrt(cross[0] * cross[0] + cross[1] * cross[1] + cross[2] * cross[2]);
+                for (uint32_t k = 0; k < 3; ++k) {
+                    centroid[k] += (p0[k] + p1[k] + p2[k]) * (triangleArea / 3.0f);
+                    normal[k] += cross[k];
+                }
+                area += triangleArea;
+            }
+
+            float normalLength = std::sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+            float inverseArea = area > 0.0f ? 1.0f / area : 0.0f;
+            float inverseNormalLength = normalLength > 0.0f ? 1.0f / normalLength : 0.0f;
+            float key = 0.0f;
+            for (uint32_t k = 0; k < 3; ++k) {
+                key += (centroid[k] * inverseArea - static_cast<float>(meshCentroid[k])) * normal[k] * inverseNormalLength;
+            }
+            sortKeys[c] = key;
+        }
+
+        std::vector<uint32_t> order(clusterCount);
+        std::iota(order.begin(), order.end(), 0u);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return sortKeys[a] > sortKeys[b]; });
+
+        std::vector<uint32_t> output;
+        output.reserve(triangleCount * 3);
+        for (uint32_t c : order) {
+            output.insert(output.end(), indices.begin() + clusters[c] * 3, indices.begin() + clusters[c + 1] * 3);
+        }
+        std::copy(output.begin(), output.end(), indices.begin());
+    }
+
+    // ------------------------------------------------------------------------
+    // Vertex fetch optimisation
+    // ------------------------------------------------------------------------
+
+    uint32_t MeshOptimizer::optimize_vertex_fetch(std::vector<std::byte>& vertices, uint32_t stride, std::span<uint32_t> indices) {
+        uint32_t vertexCount = static_cast<uint32_t>(vertices.size() / stride);
+        std::vector<uint32_t> remap(vertexCount, INVALID_INDEX);
+
+        uint32_t nextVertex = 0;
+        for (uint32_t& index : indices) {
+            if (index >= vertexCount) {
+                throw MeshOptimizerException("Index references a vertex past the end of the mesh");
+            }
+            if (remap[index] == INVALID_INDEX) {
+                remap[index] = nextVertex++;
+            }
+            index = remap[index];
+        }
+
+        remap_vertices(vertices, stride, remap, nextVertex);
+        return nextVertex;
+    }
+
+    // ------------------------------------------------------------------------
+    // Analysis
+    // ------------------------------------------------------------------------
+
+    VertexCacheStats MeshOptimizer::analyze_vertex_cache(std::span<const uint32_t> indices, uint32_t vertexCount, uint32_t cacheSize) {
+        VertexCacheStats stats;
+        uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+        if (triangleCount == 0 || vertexCount == 0) {
+            return stats;
+        }
+
+        // A vertex is cached if fewer than cacheSize misses happened since it was last loaded
+        std::vector<uint32_t> timestamp(vertexCount, 0);
+        uint32_t time = cacheSize + 1;
+        for (uint32_t index : indices.first(triangleCount * 3)) {
+            if (index >= vertexCount) {
+                continue;
+            }
+            if (time - timestamp[index] > cacheSize) {
+                timestamp[index] = time++;
+                stats.vertexTransforms++;
+            }
+        }
+
+        stats.acmr = static_cast<float>(stats.vertexTransforms) / static_cast<float>(triangleCount);
+        stats.atvr = static_cast<float>(stats.vertexTransforms) / static_cast<float>(vertexCount);
+        return stats;
+    }
+
+    // ------------------------------------------------------------------------
+    // Pipeline
+    // ------------------------------------------------------------------------
+
+    MeshOptimizerReport MeshOptimizer::optimize(std::vector<std::byte>& vertices, uint32_t stride, std::vector<uint32_t>& indices,
+                                                std::span<const std::array<float, 3>> positions) const {
+        if (stride == 0) {
+            throw MeshOptimizerException("Vertex stride cannot be zero");
+        }
+
+        MeshOptimizerReport report;
+        report.verticesBefore = static_cast<uint32_t>(vertices.size() / stride);
+        if (!positions.empty() && positions.size() != report.verticesBefore) {
+            throw MeshOptimizerException("Position count does not match the vertex count");
+        }
+
+        if (indices.empty()) {
+            // Non-indexed triangle list: every vertex is referenced once, in order
+            indices.resize(report.verticesBefore);
+            std::iota(indices.begin(), indices.end(), 0u);
+        } else if (std::any_of(indices.begin(), indices.end(), [&](uint32_t index) { return index >= report.verticesBefore; })) {
+            throw MeshOptimizerException("Index references a vertex past the end of the mesh");
+        }
+        indices.resize(indices.size() / 3 * 3);
+        report.triangles = static_cast<uint32_t>(indices.size() / 3);
+        report.before = analyze_vertex_cache(indices, report.verticesBefore, m_options.cacheSize);
+
+        // Positions follow the vertices through deduplication
+        bool overdraw = m_options.optimizeOverdraw && !positions.empty();
+        std::vector<std::array<float, 3>> vertexPositions;
+        if (overdraw) {
+            vertexPositions.assign(positions.begin(), positions.end());
+        }
+
+        uint32_t vertexCount = report.verticesBefore;
+        if (m_options.deduplicate) {
+            std::vector<uint32_t> remap;
+            vertexCount = generate_vertex_remap(vertices, stride, remap);
+            if (vertexCount != report.verticesBefore) {
+                for (uint32_t& index : indices) {
+                    index = remap[index];
+                }
+                remap_vertices(vertices, stride, remap, vertexCount);
+                if (overdraw) {
+                    std::vector<std::array<float, 3>> remapped(vertexCount);
+                    for (uint32_t i = 0; i < remap.size(); ++i) {
+                        remapped[remap[i]] = vertexPositions[i];
+                    }
+                    vertexPositions = std::move(remapped);
+                }
+            }
+        }
+
+        if (m_options.optimizeVertexCache) {
+            optimize_vertex_cache(indices, vertexCount, m_options.cacheSize);
+        }
+
+        if (overdraw) {
+            optimize_overdraw(indices, vertexPositions, m_options.cacheSize, m_options.overdrawThreshold);
+        }
+
+        if (m_options.optimizeVertexFetch) {
+            vertexCount = optimize_vertex_fetch(vertices, stride, indices);
+        }
+
+        report.verticesAfter = vertexCount;
+        report.after = analyze_vertex_cache(indices, vertexCount, m_options.cacheSize);
+        return report;
+    }
+
+} // namespace minecart::graphics
@@ -1,204 +1,499 @@
 #include "minecart/model.hpp"
+#include "minecart/instance_buffer.hpp"
+#include "minecart/profiler.hpp"
 
+#include <algorithm>
 #include <cstring>
 #include <stdexcept>
 
 namespace minecart::graphics {
 
-    Model::Model(SDL_GPUDevice* device)
+    Model::Model(SDL_GPUDevice* device, UploadQueue* uploadQueue, GpuBufferArena* arena)
         : m_device(device)
-        , m_vertexBuffer(nullptr, SDLGPUBufferDeleter{device})
-        , m_indexBuffer(nullptr, SDLGPUBufferDeleter{device})
+        , m_uploadQueue(uploadQueue ? uploadQueue : (arena ? arena->get_upload_queue() : nullptr))
+        , m_arena(arena)
+        , m_vertexBuffer(nullptr, SDLGPUBufferDeleter{device, m_uploadQueue})
+        , m_indexBuffer(nullptr, SDLGPUBufferDeleter{device, m_uploadQueue})
     {
         if (!device) {
             throw ModelException("Device cannot be null");
         }
     }
 
-    void Model::set_vertices(std::span<const Vertex> vertices) {
-        m_vertices.assign(vertices.begin(), vertices.end());
-        m_vertexCount = static_cast<uint32_t>(vertices.size());
+    void Model::set_vertex_data(std::span<const std::byte> data, uint32_t stride, const SDL_GPUVertexInputState* inputState) {
+        if (stride != m_vertexStride && (m_vertexBuffer || m_vertexAllocation)) {
+            // Capacity and arena alignment are expressed in vertices of the old stride
+            m_vertexBuffer.reset();
+            m_vertexAllocation.reset();
+            m_vertexCapacity = 0;
+        }
+        m_vertexData.assign(data.begin(), data.end());
+        m_vertexStride = stride;
+        m_vertexInputState = inputState;
+        m_vertexCount = static_cast<uint32_t>(data.size() / stride);
         m_uploaded = false;
     }
 
+    // 0xFFFF is left out so a strip pipeline with primitive restart never sees a restart index
+    static constexpr uint32_t MAX_INDEX_16 = 0xFFFE;
+
+    static bool fits_16_bit(std::span<const uint32_t> indices) {
+        return std::all_of(indices.begin(), indices.end(), [](uint32_t index) { return index <= MAX_INDEX_16; });
+    }
+
+    template<typename To, typename From>
+    static std::vector<To> convert_indices(std::span<const From> indices) {
+        std::vector<To> converted(indices.size());
+        std::transform(indices.begin(), indices.end(), converted.begin(),
+                       [](From index) { return static_cast<To>(index); });
+        return converted;
+    }
+
     void Model::set_indices(std::span<const uint32_t> indices) {
-        m_indices.assign(indices.begin(), indices.end());
-        m_indexCount = static_cast<uint32_t>(indices.size());
-        m_useIndexBuffer = !indices.empty();
+        if (fits_16_bit(indices)) {
+            set_indices(std::span<const uint16_t>(convert_indices<uint16_t>(indices)));
+            return;
+        }
+        set_index_data(std::as_bytes(indices), sizeof(uint32_t));
+    }
+
+    void Model::set_indices(std::span<const uint16_t> indices) {
+        set_index_data(std::as_bytes(indices), sizeof(uint16_t));
+    }
+
+    void Model::set_index_size(uint32_t indexSize) {
+        if (indexSize != m_indexSize && (m_indexBuffer || m_indexAllocation)) {
+            // Capacity and arena alignment are expressed in indices of the old size
+            m_indexBuffer.reset();
+            m_indexAllocation.reset();
+            m_indexCapacity = 0;
+        }
+        m_indexSize = indexSize;
+    }
+
+    void Model::set_index_data(std::span<const std::byte> data, uint32_t indexSize) {
+        set_index_size(indexSize);
+        m_indexData.assign(data.begin(), data.end());
+        m_indexCount = static_cast<uint32_t>(data.size() / indexSize);
+        m_useIndexBuffer = m_indexCount > 0;
         m_uploaded = false;
     }
 
-    void Model::upload_vertex_data() {
-        if (m_vertices.empty()) {
-            throw ModelException("No vertices to upload");
+    void Model::widen_indices() {
+        auto narrow = std::span<const uint16_t>(reinterpret_cast<const uint16_t*>(m_indexData.data()), m_indexCount);
+        std::vector<uint32_t> wide = convert_indices<uint32_t>(narrow);
+        auto bytes = std::as_bytes(std::span<const uint32_t>(wide));
+        m_indexData.assign(bytes.begin(), bytes.end());
+        m_indexSize = sizeof(uint32_t);
+
+        // Existing storage holds 16-bit indices; the next write replaces it
+        m_indexBuffer.reset();
+        m_indexAllocation.reset();
+        m_indexCapacity = 0;
+    }
+
+    template<typename Fn>
+    void Model::with_upload_queue(Fn&& fn) {
+        if (m_uploadQueue) {
+            fn(*m_uploadQueue);
+            return;
+        }
+
+        // No shared queue: batch everything recorded by fn into a single submit
+        UploadQueue queue(m_device);
+        fn(queue);
+        try {
+            queue.flush();
+        }
+        catch (const UploadException& e) {
+            throw ModelException(e.what());
+        }
+    }
+
+    ArenaAllocation Model::allocate_from_arena(uint32_t size, uint32_t alignment) {
+        try {
+            return ArenaAllocation(m_arena, m_arena->allocate(size, alignment));
         }
+        catch (const ArenaException& e) {
+            throw ModelException(e.what());
+        }
+    }
 
-        size_t bufferSize = m_vertices.size() * sizeof(Vertex);
+    bool Model::ensure_vertex_storage(uint32_t vertexCount) {
+        bool hasStorage = m_vertexBuffer || m_vertexAllocation;
+        if (hasStorage && vertexCount <= m_vertexCapacity) {
+            return false;
+        }
 
-        // Create vertex buffer
-        SDL_GPUBufferCreateInfo bufferInfo{};
-        bufferInfo.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
-        bufferInfo.size = static_cast<Uint32>(bufferSize);
+        // Grow geometrically so streaming appends amortise to a few reallocations
+        uint32_t capacity = std::max(vertexCount, m_reservedVertices);
+        if (hasStorage) {
+            capacity = std::max(capacity, m_vertexCapacity * 2);
+        }
+        size_t bufferSize = static_cast<size_t>(capacity) * m_vertexStride;
 
-        SDL_GPUBuffer* vertexBuffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
-        if (!vertexBuffer) {
-            throw ModelException(std::string("Failed to create vertex buffer: ") + SDL_GetError());
+        if (m_arena) {
+            // Stride alignment keeps offset / stride a whole base vertex
+            m_vertexAllocation = allocate_from_arena(static_cast<uint32_t>(bufferSize), m_vertexStride);
+        } else {
+            // Create vertex buffer
+            SDL_GPUBufferCreateInfo bufferInfo{};
+            bufferInfo.usage = SDL_GPU_BUFFERUSAGE_VERTEX;
+            bufferInfo.size = static_cast<Uint32>(bufferSize);
+
+            SDL_GPUBuffer* vertexBuffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+            if (!vertexBuffer) {
+                throw ModelException(std::string("Failed to create vertex buffer: ") + SDL_GetError());
+            }
+            GpuStats::get().track_buffer(vertexBuffer, bufferInfo.size);
+            m_vertexBuffer.reset(vertexBuffer);
         }
-        m_vertexBuffer.reset(vertexBuffer);
+        m_vertexCapacity = capacity;
+        return true;
+    }
 
-        // Create transfer buffer for uploading data
-        SDL_GPUTransferBufferCreateInfo transferInfo{};
-        transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        transferInfo.size = static_cast<Uint32>(bufferSize);
+    bool Model::ensure_index_storage(uint32_t indexCount) {
+        bool hasStorage = m_indexBuffer || m_indexAllocation;
+        if (hasStorage && indexCount <= m_indexCapacity) {
+            return false;
+        }
 
-        SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(m_device, &transferInfo);
-        if (!transferBuffer) {
-            throw ModelException(std::string("Failed to create transfer buffer: ") + SDL_GetError());
+        uint32_t capacity = std::max(indexCount, m_reservedIndices);
+        if (hasStorage) {
+            capacity = std::max(capacity, m_indexCapacity * 2);
         }
+        size_t bufferSize = static_cast<size_t>(capacity) * m_indexSize;
 
-        // Map and copy data
-        void* mappedData = SDL_MapGPUTransferBuffer(m_device, transferBuffer, false);
-        if (!mappedData) {
-            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
-            throw ModelException(std::string("Failed to map transfer buffer: ") + SDL_GetError());
+        if (m_arena) {
+            m_indexAllocation = allocate_from_arena(static_cast<uint32_t>(bufferSize), m_indexSize);
+        } else {
+            // Create index buffer
+            SDL_GPUBufferCreateInfo bufferInfo{};
+            bufferInfo.usage = SDL_GPU_BUFFERUSAGE_INDEX;
+            bufferInfo.size = static_cast<Uint32>(bufferSize);
+
+            SDL_GPUBuffer* indexBuffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
+            if (!indexBuffer) {
+                throw ModelException(std::string("Failed to create index buffer: ") + SDL_GetError());
+            }
+            GpuStats::get().track_buffer(indexBuffer, bufferInfo.size);
+            m_indexBuffer.reset(indexBuffer);
         }
-        std::memcpy(mappedData, m_vertices.data(), bufferSize);
-        SDL_UnmapGPUTransferBuffer(m_device, transferBuffer);
+        m_indexCapacity = capacity;
+        return true;
+    }
 
-        // Upload to GPU
-        SDL_GPUCommandBuffer* uploadCmdBuffer = SDL_AcquireGPUCommandBuffer(m_device);
-        if (!uploadCmdBuffer) {
-            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
-            throw ModelException(std::string("Failed to acquire command buffer: ") + SDL_GetError());
+    ArenaRegion Model::get_vertex_region() const {
+        if (m_vertexAllocation) {
+            return m_vertexAllocation.get_region();
         }
+        return ArenaRegion{m_vertexBuffer.get(), 0, m_vertexCapacity * m_vertexStride};
+    }
 
-        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(uploadCmdBuffer);
-        if (!copyPass) {
-            SDL_SubmitGPUCommandBuffer(uploadCmdBuffer);
-            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
-            throw ModelException(std::string("Failed to begin copy pass: ") + SDL_GetError());
+    ArenaRegion Model::get_index_region() const {
+        if (m_indexAllocation) {
+            return m_indexAllocation.get_region();
         }
+        return ArenaRegion{m_indexBuffer.get(), 0, m_indexCapacity * m_indexSize};
+    }
 
-        SDL_GPUTransferBufferLocation srcLocation{};
-        srcLocation.transfer_buffer = transferBuffer;
-        srcLocation.offset = 0;
+    void Model::write_vertices(UploadQueue& queue, uint32_t first, uint32_t count, bool wholeBuffer) {
+        ArenaRegion region = get_vertex_region();
+
+        // A whole-buffer rewrite may cycle a buffer still read by frames in flight;
+        // partial writes and shared arena pages must keep their existing contents.
+        bool cycle = wholeBuffer && !m_vertexAllocation;
+        auto data = std::span<const std::byte>(m_vertexData).subspan(
+            static_cast<size_t>(first) * m_vertexStride, static_cast<size_t>(count) * m_vertexStride);
+        uint64_t ticket = queue.enqueue(region.buffer, region.offset + first * m_vertexStride, data, cycle);
+        if (wholeBuffer) {
+            m_uploadTicket = ticket;
+        }
+        m_uploadedBytes += data.size_bytes();
+    }
 
-        SDL_GPUBufferRegion dstRegion{};
-        dstRegion.buffer = m_vertexBuffer.get();
-        dstRegion.offset = 0;
-        dstRegion.size = static_cast<Uint32>(bufferSize);
+    void Model::write_indices(UploadQueue& queue, uint32_t first, uint32_t count, bool wholeBuffer) {
+        ArenaRegion region = get_index_region();
+        bool cycle = wholeBuffer && !m_indexAllocation;
+        auto data = std::span<const std::byte>(m_indexData).subspan(
+            static_cast<size_t>(first) * m_indexSize, static_cast<size_t>(count) * m_indexSize);
+        uint64_t ticket = queue.enqueue(region.buffer, region.offset + first * m_indexSize, data, cycle);
+        if (wholeBuffer) {
+            m_uploadTicket = ticket;
+        }
+        m_uploadedBytes += data.size_bytes();
+        m_indexBytesSaved += static_cast<uint64_t>(count) * (sizeof(uint32_t) - m_indexSize);
+    }
 
-        SDL_UploadToGPUBuffer(copyPass, &srcLocation, &dstRegion, false);
-        SDL_EndGPUCopyPass(copyPass);
+    void Model::upload_vertex_data(UploadQueue& queue) {
+        if (m_vertexData.empty()) {
+            throw ModelException("No vertices to upload");
+        }
 
-        SDL_SubmitGPUCommandBuffer(uploadCmdBuffer);
-        SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
+        ensure_vertex_storage(m_vertexCount);
+        write_vertices(queue, 0, m_vertexCount, true);
     }
 
-    void Model::upload_index_data() {
-        if (m_indices.empty()) {
+    void Model::upload_index_data(UploadQueue& queue) {
+        if (m_indexData.empty()) {
+            m_indexBuffer.reset();
+            m_indexAllocation.reset();
+            m_indexCapacity = 0;
             return; // No index data to upload
         }
 
-        size_t bufferSize = m_indices.size() * sizeof(uint32_t);
+        ensure_index_storage(m_indexCount);
+        write_indices(queue, 0, m_indexCount, true);
+    }
+
+    void Model::upload() {
+        MINECART_PROFILE_SCOPE("Model::upload");
+        if (m_vertexData.empty()) {
+            throw ModelException("No vertices set - call set_vertices() first");
+        }
+
+        with_upload_queue([this](UploadQueue& queue) {
+            upload_vertex_data(queue);
+            upload_index_data(queue);
+        });
+        if (!m_uploadQueue) {
+            m_uploadTicket = 0;
+        }
+        m_uploaded = true;
+    }
 
-        // Create index buffer
-        SDL_GPUBufferCreateInfo bufferInfo{};
-        bufferInfo.usage = SDL_GPU_BUFFERUSAGE_INDEX;
-        bufferInfo.size = static_cast<Uint32>(bufferSize);
+    MeshOptimizerReport Model::upload(const MeshOptimizer& optimizer) {
+        MINECART_PROFILE_SCOPE("Model::upload");
+        if (m_vertexData.empty()) {
+            throw ModelException("No vertices set - call set_vertices() first");
+        }
 
-        SDL_GPUBuffer* indexBuffer = SDL_CreateGPUBuffer(m_device, &bufferInfo);
-        if (!indexBuffer) {
-            throw ModelException(std::string("Failed to create index buffer: ") + SDL_GetError());
+        std::vector<uint32_t> indices(m_indexCount);
+        if (m_indexSize == sizeof(uint16_t)) {
+            auto narrow = std::span<const uint16_t>(reinterpret_cast<const uint16_t*>(m_indexData.data()), m_indexCount);
+            std::copy(narrow.begin(), narrow.end(), indices.begin());
+        } else if (m_indexCount > 0) {
+            std::memcpy(indices.data(), m_indexData.data(), m_indexData.size());
         }
-        m_indexBuffer.reset(indexBuffer);
 
-        // Create transfer buffer
-        SDL_GPUTransferBufferCreateInfo transferInfo{};
-        transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
-        transferInfo.size = static_cast<Uint32>(bufferSize);
+        std::vector<std::array<float, 3>> positions;
+        if (m_decodePosition) {
+            positions.resize(m_vertexData.size() / m_vertexStride);
+            for (size_t i = 0; i < positions.size(); ++i) {
+                positions[i] = m_decodePosition(m_vertexData.data() + static_cast<size_t>(i) * m_vertexStride);
+            }
+        }
 
-        SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(m_device, &transferInfo);
-        if (!transferBuffer) {
-            throw ModelException(std::string("Failed to create transfer buffer: ") + SDL_GetError());
+        MeshOptimizerReport report;
+        try {
+            report = optimizer.optimize(m_vertexData, m_vertexStride, indices, positions);
         }
+        catch (const MeshOptimizerException& e) {
+            throw ModelException(e.what());
+        }
+        m_vertexCount = report.verticesAfter;
+        set_indices(std::span<const uint32_t>(indices));
+
+        upload();
+        return report;
+    }
 
-        // Map and copy data
-        void* mappedData = SDL_MapGPUTransferBuffer(m_device, transferBuffer, false);
-        if (!mappedData) {
-            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
-            throw ModelException(std::string("Failed to map transfer buffer: ") + SDL_GetError());
+    void Model::reserve(uint32_t vertexCapacity, uint32_t indexCapacity) {
+        m_reservedVertices = vertexCapacity;
+        m_reservedIndices = indexCapacity;
+        m_vertexData.reserve(static_cast<size_t>(vertexCapacity) * m_vertexStride);
+        m_indexData.reserve(static_cast<size_t>(indexCapacity) * m_indexSize);
+
+        if (!m_uploaded) {
+            return; // Applied when the mesh is first uploaded
         }
-        std::memcpy(mappedData, m_indices.data(), bufferSize);
-        SDL_UnmapGPUTransferBuffer(m_device, transferBuffer);
 
-        // Upload to GPU
-        SDL_GPUCommandBuffer* uploadCmdBuffer = SDL_AcquireGPUCommandBuffer(m_device);
-        if (!uploadCmdBuffer) {
-            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
-            throw ModelException(std::string("Failed to acquire command buffer: ") + SDL_GetError());
+        // Grow existing storage now and carry the current contents over
+        with_upload_queue([&](UploadQueue& queue) {
+            if (vertexCapacity > m_vertexCapacity && ensure_vertex_storage(vertexCapacity)) {
+                write_vertices(queue, 0, m_vertexCount, true);
+            }
+            if (indexCapacity > m_indexCapacity && ensure_index_storage(indexCapacity) && m_indexCount > 0) {
+                write_indices(queue, 0, m_indexCount, true);
+            }
+        });
+    }
+
+    void Model::update_vertex_data(uint32_t offset, std::span<const std::byte> data, uint32_t stride) {
+        if (stride != m_vertexStride) {
+            throw ModelException("Vertex update uses a different vertex layout than the mesh");
+        }
+        if (offset > m_vertexCount) {
+            throw ModelException("Vertex update starts past the end of the mesh");
+        }
+        if (data.empty()) {
+            return;
         }
 
-        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(uploadCmdBuffer);
-        if (!copyPass) {
-            SDL_SubmitGPUCommandBuffer(uploadCmdBuffer);
-            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
-            throw ModelException(std::string("Failed to begin copy pass: ") + SDL_GetError());
+        uint32_t count = static_cast<uint32_t>(data.size() / stride);
+        uint32_t end = offset + count;
+        size_t byteOffset = static_cast<size_t>(offset) * stride;
+        if (byteOffset + data.size() > m_vertexData.size()) {
+            m_vertexData.resize(byteOffset + data.size());
         }
+        std::copy(data.begin(), data.end(), m_vertexData.begin() + byteOffset);
+        m_vertexCount = std::max(m_vertexCount, end);
 
-        SDL_GPUTransferBufferLocation srcLocation{};
-        srcLocation.transfer_buffer = transferBuffer;
-        srcLocation.offset = 0;
+        if (!m_uploaded) {
+            return; // Picked up by the next upload()
+        }
 
-        SDL_GPUBufferRegion dstRegion{};
-        dstRegion.buffer = m_indexBuffer.get();
-        dstRegion.offset = 0;
-        dstRegion.size = static_cast<Uint32>(bufferSize);
+        with_upload_queue([&](UploadQueue& queue) {
+            if (ensure_vertex_storage(m_vertexCount)) {
+                write_vertices(queue, 0, m_vertexCount, true);
+            } else {
+                write_vertices(queue, offset, count, false);
+            }
+        });
+    }
 
-        SDL_UploadToGPUBuffer(copyPass, &srcLocation, &dstRegion, false);
-        SDL_EndGPUCopyPass(copyPass);
+    void Model::update_indices(uint32_t offset, std::span<const uint32_t> indices) {
+        if (m_indexCount == 0) {
+            // No indices yet, so no width to keep: start from the narrowest that fits
+            set_index_size(fits_16_bit(indices) ? sizeof(uint16_t) : sizeof(uint32_t));
+        }
+        if (m_indexSize == sizeof(uint16_t)) {
+            if (!fits_16_bit(indices)) {
+                widen_indices();
+            } else {
+                std::vector<uint16_t> narrow = convert_indices<uint16_t>(indices);
+                update_index_data(offset, std::as_bytes(std::span<const uint16_t>(narrow)));
+                return;
+            }
+        }
+        update_index_data(offset, std::as_bytes(indices));
+    }
 
-        SDL_SubmitGPUCommandBuffer(uploadCmdBuffer);
-        SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
+    void Model::update_indices(uint32_t offset, std::span<const uint16_t> indices) {
+        if (m_indexCount == 0) {
+            set_index_size(sizeof(uint16_t));
+        }
+        if (m_indexSize == sizeof(uint32_t)) {
+            std::vector<uint32_t> wide = convert_indices<uint32_t>(indices);
+            update_index_data(offset, std::as_bytes(std::span<const uint32_t>(wide)));
+            return;
+        }
+        update_index_data(offset, std::as_bytes(indices));
     }
 
-    void Model::upload() {
-        if (m_vertices.empty()) {
-            throw ModelException("No vertices set - call set_vertices() first");
+    void Model::update_index_data(uint32_t offset, std::span<const std::byte> data) {
+        if (offset > m_indexCount) {
+            throw ModelException("Index update starts past the end of the mesh");
+        }
+        if (data.empty()) {
+            return;
         }
 
-        upload_vertex_data();
-        upload_index_data();
-        m_uploaded = true;
+        uint32_t count = static_cast<uint32_t>(data.size() / m_indexSize);
+        uint32_t end = offset + count;
+        size_t byteOffset = static_cast<size_t>(offset) * m_indexSize;
+        if (byteOffset + data.size() > m_indexData.size()) {
+            m_indexData.resize(byteOffset + data.size());
+        }
+        std::copy(data.begin(), data.end(), m_indexData.begin() + byteOffset);
+        m_indexCount = std::max(m_indexCount, end);
+        m_useIndexBuffer = true;
+
+        if (!m_uploaded) {
+            return; // Picked up by the next upload()
+        }
+
+        with_upload_queue([&](UploadQueue& queue) {
+            if (ensure_index_storage(m_indexCount)) {
+                write_indices(queue, 0, m_indexCount, true);
+            } else {
+                write_indices(queue, offset, count, false);
+            }
+        });
+    }
+
+    void Model::truncate(uint32_t vertexCount, uint32_t indexCount) {
+        m_vertexCount = std::min(m_vertexCount, vertexCount);
+        m_indexCount = std::min(m_indexCount, indexCount);
+        m_vertexData.resize(static_cast<size_t>(m_vertexCount) * m_vertexStride);
+        m_indexData.resize(static_cast<size_t>(m_indexCount) * m_indexSize);
+        m_useIndexBuffer = m_indexCount > 0;
     }
 
     void Model::render(SDL_GPURenderPass* renderPass) const {
-        if (!is_ready()) {
+        render_instanced(renderPass, 1, 0);
+    }
+
+    void Model::render_instanced(SDL_GPURenderPass* renderPass, const InstanceBufferBase& instances) const {
+        if (!is_ready() || !instances.is_ready()) {
             return; // Silently skip if not ready
         }
 
-        // Bind vertex buffer
+        // Instances added since the last upload() are not on the GPU yet
+        instances.bind(renderPass, instances.get_usage() == InstanceBufferUsage::Vertex ? 1 : 0);
+        render_instanced(renderPass, instances.get_uploaded_count(), 0);
+    }
+
+    void Model::render_instanced(SDL_GPURenderPass* renderPass, uint32_t instanceCount, uint32_t firstInstance) const {
+        if (!is_ready() || instanceCount == 0) {
+            return; // Silently skip if not ready
+        }
+
+        ModelDrawInfo info = get_draw_info();
+
+        // Bind vertex buffer (arena meshes share the page buffer and draw from a base vertex)
         SDL_GPUBufferBinding vertexBufferBinding{};
-        vertexBufferBinding.buffer = m_vertexBuffer.get();
+        vertexBufferBinding.buffer = info.vertexBuffer;
         vertexBufferBinding.offset = 0;
 
         SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+        GpuStats::get().add_buffer_binds(1);
 
         // Draw
-        if (m_useIndexBuffer && m_indexBuffer) {
+        if (info.indexBuffer) {
             SDL_GPUBufferBinding indexBufferBinding{};
-            indexBufferBinding.buffer = m_indexBuffer.get();
+            indexBufferBinding.buffer = info.indexBuffer;
             indexBufferBinding.offset = 0;
 
-            SDL_BindGPUIndexBuffer(renderPass, &indexBufferBinding, SDL_GPU_INDEXELEMENTSIZE_32BIT);
-            SDL_DrawGPUIndexedPrimitives(renderPass, m_indexCount, 1, 0, 0, 0);
+            SDL_BindGPUIndexBuffer(renderPass, &indexBufferBinding, info.indexElementSize);
+            GpuStats::get().add_buffer_binds(1);
+            SDL_DrawGPUIndexedPrimitives(renderPass, info.count, instanceCount, info.first, info.baseVertex, firstInstance);
         } else {
-            SDL_DrawGPUPrimitives(renderPass, m_vertexCount, 1, 0, 0);
+            SDL_DrawGPUPrimitives(renderPass, info.count, instanceCount, info.first, firstInstance);
         }
+        GpuStats::get().add_draw(info.count, instanceCount);
+    }
+
+    ModelDrawInfo Model::get_draw_info() const {
+        ModelDrawInfo info;
+        if (!m_uploaded || !(m_vertexBuffer || m_vertexAllocation) || m_vertexCount == 0) {
+            return info;
+        }
+
+        ArenaRegion vertexRegion = get_vertex_region();
+        info.vertexBuffer = vertexRegion.buffer;
+        info.baseVertex = static_cast<int32_t>(vertexRegion.offset / m_vertexStride);
+
+        if (m_useIndexBuffer && (m_indexBuffer || m_indexAllocation)) {
+            ArenaRegion indexRegion = get_index_region();
+            info.indexBuffer = indexRegion.buffer;
+            info.indexElementSize = m_indexSize == sizeof(uint16_t)
+                ? SDL_GPU_INDEXELEMENTSIZE_16BIT
+                : SDL_GPU_INDEXELEMENTSIZE_32BIT;
+            info.first = indexRegion.offset / m_indexSize;
+            info.count = m_indexCount;
+        } else {
+            info.first = static_cast<uint32_t>(info.baseVertex);
+            info.count = m_vertexCount;
+        }
+        return info;
     }
 
     bool Model::is_ready() const noexcept {
-        return m_uploaded && m_vertexBuffer && m_vertexCount > 0;
+        if (m_uploadQueue && !m_uploadQueue->is_complete(m_uploadTicket)) {
+            return false; // Copy not recorded yet
+        }
+        return m_uploaded && (m_vertexBuffer || m_vertexAllocation) && m_vertexCount > 0;
     }
 
 } // namespace minecart::graphics
@@ -0,0 +1,206 @@
+#include "minecart/pipeline_cache.hpp"
+#include "minecart/hash.hpp"
+#include "minecart/profiler.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstring>
+
+namespace minecart::graphics {
+
+    namespace {
+
+        template<typename T>
+        void append(std::vector<uint8_t>& out, const T& value) {
+            const size_t offset = out.size();
+            out.resize(offset + sizeof(T));
+            std::memcpy(out.data() + offset, &value, sizeof(T));
+        }
+
+        void append_stencil(std::vector<uint8_t>& out, const SDL_GPUStencilOpState& state) {
+            append(out, state.fail_op);
+            append(out, state.pass_op);
+            append(out, state.depth_fail_op);
+            append(out, state.compare_op);
+        }
+
+        void append_blend(std::vector<uint8_t>& out, const SDL_GPUColorTargetBlendState& state) {
+            append(out, state.enable_blend);
+            if (state.enable_blend) {
+                append(out, state.src_color_blendfactor);
+                append(out, state.dst_color_blendfactor);
+                append(out, state.color_blend_op);
+                append(out, state.src_alpha_blendfactor);
+                append(out, state.dst_alpha_blendfactor);
+                append(out, state.alpha_blend_op);
+            }
+            append(out, state.enable_color_write_mask);
+            if (state.enable_color_write_mask) {
+                append(out, state.color_write_mask);
+            }
+        }
+
+        // Field by field (padding bytes are not guaranteed to be zero), following
+        // the arrays the create info points at. Fields that are ignored given the
+        // rest of the state are skipped, so they don't split otherwise equal keys.
+        void serialize(const SDL_GPUGraphicsPipelineCreateInfo& info, std::vector<uint8_t>& out) {
+            out.clear();
+            append(out, info.vertex_shader);
+            append(out, info.fragment_shader);
+
+            const SDL_GPUVertexInputState& input = info.vertex_input_state;
+            append(out, input.num_vertex_buffers);
+            for (Uint32 i = 0; i < input.num_vertex_buffers; ++i) {
+                const SDL_GPUVertexBufferDescription& buffer = input.vertex_buffer_descriptions[i];
+                append(out, buffer.slot);
+                append(out, buffer.pitch);
+                append(out, buffer.input_rate);
+                append(out, buffer.instance_step_rate);
+            }
+            append(out, input.num_vertex_attributes);
+            for (Uint32 i = 0; i < input.num_vertex_attributes; ++i) {
+                const SDL_GPUVertexAttribute& attribute = input.vertex_attributes[i];
+                append(out, attribute.location);
+                append(out, attribute.buffer_slot);
+                append(out, attribute.format);
+                append(out, attribute.offset);
+            }
+
+            append(out, info.primitive_type);
+
+            const SDL_GPURasterizerState& raster = info.rasterizer_state;
+            append(out, raster.fill_mode);
+            append(out, raster.cull_mode);
+            append(out, raster.front_face);
+            append(out, raster.enable_depth_clip);
+            append(out, raster.enable_depth_bias);
+            if (raster.enable_depth_bias) {
+                append(out, raster.depth_bias_constant_factor);
+                append(out, raster.depth_bias_clamp);
+                append(out, raster.depth_bias_slope_factor);
+            }
+
+            const SDL_GPUMultisampleState& multisample = info.multisample_state;
+            append(out, multisample.sample_count);
+            append(out, multisample.enable_mask);
+            if (multisample.enable_mask) {
+                append(out, multisample.sample_mask);
+            }
+            append(out, multisample.enable_alpha_to_coverage);
+
+            const SDL_GPUDepthStencilState& depth = info.depth_stencil_state;
+            append(out, depth.enable_depth_test);
+            append(out, depth.enable_depth_write);
+            if (depth.enable_depth_test) {
+                append(out, depth.compare_op);
+            }
+            append(out, depth.enable_stencil_test);
+            if (depth.enable_stencil_test) {
+                append_stencil(out, depth.front_stencil_state);
+                append_stencil(out, depth.back_stencil_state);
+                append(out, depth.compare_mask);
+                append(out, depth.write_mask);
+            }
+
+            const SDL_GPUGraphicsPipelineTargetInfo& targets = info.target_info;
+            append(out, targets.num_color_targets);
+            for (Uint32 i = 0; i < targets.num_color_targets; ++i) {
+                const SDL_GPUColorTargetDescription& target = targets.color_target_descriptions[i];
+                append(out, target.format);
+                append_blend(out, target.blend_state);
+            }
+            append(out, targets.has_depth_stencil_target);
+            if (targets.has_depth_stencil_target) {
+                append(out, targets.depth_stencil_format);
+            }
+
+            append(out, info.props);
+        }
+
+    } // namespace
+
+    PipelineCache::PipelineCache(SDL_GPUDevice* device)
+        : m_device(device)
+    {
+        if (!device) {
+            throw PipelineCacheException("Device cannot be null");
+        }
+    }
+
+    uint64_t PipelineCache::compute_hash(const SDL_GPUGraphicsPipelineCreateInfo& info) {
+        std::vector<uint8_t> bytes;
+        serialize(info, bytes);
+        return fnv1a(bytes.data(), bytes.size());
+    }
+
+    SDL_GPUGraphicsPipeline* PipelineCache::get(const SDL_GPUGraphicsPipelineCreateInfo& info) {
+        serialize(info, m_scratch);
+        const uint64_t hash = fnv1a(m_scratch.data(), m_scratch.size());
+
+        auto it = m_entries.find(hash);
+        if (it != m_entries.end()) {
+            for (const Entry& entry : it->second) {
+                if (entry.key == m_scratch) {
+                    m_hits++;
+                    return entry.pipeline.get();
+                }
+            }
+        }
+        return create(info, hash);
+    }
+
+    SDL_GPUGraphicsPipeline* PipelineCache::create(const SDL_GPUGraphicsPipelineCreateInfo& info, uint64_t hash) {
+        MINECART_PROFILE_SCOPE("PipelineCache::create");
+        const uint64_t start = SDL_GetTicksNS();
+        GPUGraphicsPipelinePtr pipeline(SDL_CreateGPUGraphicsPipeline(m_device, &info), SDLGPUGraphicsPipelineDeleter{m_device});
+        const uint64_t elapsed = SDL_GetTicksNS() - start;
+        if (!pipeline) {
+            throw PipelineCacheException("Failed to create graphics pipeline: " + std::string(SDL_GetError()));
+        }
+
+        m_misses++;
+        m_creationTimeNS += elapsed;
+        m_maxCreationTimeNS = std::max(m_maxCreationTimeNS, elapsed);
+        spdlog::debug("Created graphics pipeline {:016x} in {:.2f} ms", hash, elapsed * 1e-6);
+
+        SDL_GPUGraphicsPipeline* result = pipeline.get();
+        m_entries[hash].push_back(Entry{m_scratch, std::move(pipeline)});
+        m_pipelineCount++;
+        return result;
+    }
+
+    void PipelineCache::prewarm(const std::vector<SDL_GPUGraphicsPipelineCreateInfo>& states) {
+        MINECART_PROFILE_SCOPE("PipelineCache::prewarm");
+        const uint64_t misses = m_misses;
+        const uint64_t creationTimeNS = m_creationTimeNS;
+        for (const SDL_GPUGraphicsPipelineCreateInfo& state : states) {
+            (void)get(state);
+        }
+        spdlog::info("Prewarmed {} graphics pipelines ({} new) in {:.1f} ms",
+            states.size(), m_misses - misses, (m_creationTimeNS - creationTimeNS) * 1e-6);
+    }
+
+    void PipelineCache::clear() {
+        m_entries.clear();
+        m_pipelineCount = 0;
+    }
+
+    PipelineCacheStats PipelineCache::get_stats() const noexcept {
+        PipelineCacheStats stats;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.creationTimeNS = m_creationTimeNS;
+        stats.maxCreationTimeNS = m_maxCreationTimeNS;
+        stats.pipelines = m_pipelineCount;
+        return stats;
+    }
+
+    void PipelineCache::log_stats() const {
+        PipelineCacheStats stats = get_stats();
+        spdlog::info("Pipeline cache: {} pipelines, {} hits / {} misses ({:.1f}% hit rate), created in {:.1f} ms (slowest {:.2f} ms)",
+            stats.pipelines, stats.hits, stats.misses, stats.hit_rate() * 100.0,
+            stats.creationTimeNS * 1e-6, stats.maxCreationTimeNS * 1e-6);
+    }
+
+} // namespace minecart::graphics
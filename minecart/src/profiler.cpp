@@ -0,0 +1,436 @@
+#include "minecart/profiler.hpp"
+#include "minecart/hash.hpp"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+#include "imgui.h"
+
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
+namespace minecart {
+
+    namespace {
+
+        // The calling thread's profile once registered
+        thread_local ThreadProfile* t_profile = nullptr;
+
+        void write_json_string(std::ostream& out, const std::string& value) {
+            out << '"';
+            for (char c : value) {
+                switch (c) {
+                    case '"': out << "\\\""; break;
+                    case '\\': out << "\\\\"; break;
+                    case '\n': out << "\\n"; break;
+                    case '\t': out << "\\t"; break;
+                    default:
+                        if (static_cast<unsigned char>(c) < 0x20) {
+                            out << ' ';
+                        } else {
+                            out << c;
+                        }
+                }
+            }
+            out << '"';
+        }
+
+        // Stable colour per zone name, so a zone keeps its colour between frames
+        ImU32 zone_color(const char* name) {
+            uint64_t hash = fnv1a(std::string_view(name));
+            return IM_COL32(90 + (hash & 0x7F), 90 + ((hash >> 8) & 0x7F), 90 + ((hash >> 16) & 0x7F), 255);
+        }
+
+    } // namespace
+
+    // Retires the calling thread's profile when the thread exits. Kept apart from
+    // t_profile so the recording fast path reads a trivial thread_local.
+    struct ThreadProfileOwner {
+        ThreadProfile* profile = nullptr;
+
+        ~ThreadProfileOwner() {
+            if (profile) {
+                Profiler::get().retire_thread_profile(*profile);
+            }
+        }
+    };
+
+    namespace {
+        thread_local ThreadProfileOwner t_profileOwner;
+    } // namespace
+
+    // ------------------------------------------------------------------------
+    // ThreadProfile
+    // ------------------------------------------------------------------------
+
+    void ThreadProfile::record(const char* name, uint64_t start, uint64_t end, uint32_t depth) noexcept {
+        const uint64_t index = m_head.load(std::memory_order_relaxed);
+        Slot& slot = m_slots[index & (CAPACITY - 1)];
+
+        // Orders the previous m_head store before these writes: a reader that sees
+        // any of them also sees that slot index - CAPACITY is being overwritten
+        std::atomic_thread_fence(std::memory_order_release);
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.end.store(end, std::memory_order_relaxed);
+        slot.depth.store(depth, std::memory_order_relaxed);
+        m_head.store(index + 1, std::memory_order_release);
+    }
+
+    std::vector<ProfileEvent> ThreadProfile::snapshot(uint64_t since) const {
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        const uint64_t first = head > CAPACITY ? head - CAPACITY : 0;
+
+        std::vector<ProfileEvent> events;
+        events.reserve(static_cast<size_t>(head - first));
+        for (uint64_t i = first; i < head; ++i) {
+            const Slot& slot = m_slots[i & (CAPACITY - 1)];
+            ProfileEvent event;
+            event.name = slot.name.load(std::memory_order_relaxed);
+            event.start = slot.start.load(std::memory_order_relaxed);
+            event.end = slot.end.load(std::memory_order_relaxed);
+            event.depth = slot.depth.load(std::memory_order_relaxed);
+            events.push_back(event);
+        }
+
+        // Zones the writer may have overwritten while we copied are no longer trusted
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t after = m_head.load(std::memory_order_relaxed);
+        const uint64_t firstValid = after + 1 > CAPACITY ? after + 1 - CAPACITY : 0;
+        if (firstValid > first) {
+            events.erase(events.begin(), events.begin() + static_cast<ptrdiff_t>(std::min(firstValid, head) - first));
+        }
+
+        if (since > 0) {
+            std::erase_if(events, [since](const ProfileEvent& event) { return event.end < since; });
+        }
+        return events;
+    }
+
+    // ------------------------------------------------------------------------
+    // Profiler
+    // ------------------------------------------------------------------------
+
+    Profiler& Profiler::get() {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    void Profiler::new_frame() noexcept {
+        const uint64_t frame = m_frameCount.load(std::memory_order_relaxed);
+        m_frameStarts[frame % FRAME_HISTORY].store(SDL_GetTicksNS(), std::memory_order_relaxed);
+        m_frameCount.store(frame + 1, std::memory_order_release);
+    }
+
+    uint64_t Profiler::get_frame_start(uint32_t framesAgo) const noexcept {
+        const uint64_t frames = get_frame_count();
+        if (framesAgo >= frames || framesAgo >= FRAME_HISTORY) {
+            return 0;
+        }
+        return m_frameStarts[(frames - 1 - framesAgo) % FRAME_HISTORY].load(std::memory_order_relaxed);
+    }
+
+    ThreadProfile& Profiler::get_thread_profile() {
+        if (t_profile) {
+            return *t_profile;
+        }
+
+        std::lock_guard lock(m_mutex);
+        const uint32_t id = m_nextThreadId++;
+        ThreadProfile* profile = take_retired_profile();
+        if (profile) {
+            // Captures also hold m_mutex, so none sees the ring while it is reset
+            profile->m_head.store(0, std::memory_order_relaxed);
+            profile->m_depth = 0;
+            profile->m_id = id;
+            profile->m_name = "Thread " + std::to_string(id);
+            profile->m_retiredAt = 0;
+        } else {
+            m_threads.push_back(std::make_unique<ThreadProfile>(id, "Thread " + std::to_string(id)));
+            profile = m_threads.back().get();
+        }
+        t_profile = profile;
+        t_profileOwner.profile = profile;
+        return *profile;
+    }
+
+    void Profiler::retire_thread_profile(ThreadProfile& profile) noexcept {
+        std::lock_guard lock(m_mutex);
+        profile.m_retiredAt = SDL_GetTicksNS();
+        t_profile = nullptr;
+    }
+
+    ThreadProfile* Profiler::take_retired_profile() noexcept {
+        ThreadProfile* oldest = nullptr;
+        uint32_t retired = 0;
+        for (const std::unique_ptr<ThreadProfile>& profile : m_threads) {
+            if (profile->m_retiredAt == 0) {
+                continue;
+            }
+            retired++;
+            if (!oldest || profile->m_retiredAt < oldest->m_retiredAt) {
+                oldest = profile.get();
+            }
+        }
+        if (!oldest) {
+            return nullptr;
+        }
+
+        // Reuse once the panel's history no longer reaches the thread's last zones,
+        // or when too many exited threads are being kept around
+        const uint64_t historyStart = get_frame_start(FRAME_HISTORY - 1);
+        if (retired > MAX_RETIRED_THREADS || (historyStart != 0 && oldest->m_retiredAt < historyStart)) {
+            return oldest;
+        }
+        return nullptr;
+    }
+
+    void Profiler::set_thread_name(const std::string& name) {
+        ThreadProfile& profile = get_thread_profile();
+        std::lock_guard lock(m_mutex);
+        profile.m_name = name;
+    }
+
+    ProfileCapture Profiler::capture(uint64_t start, uint64_t end) const {
+        ProfileCapture capture;
+        capture.start = start;
+        capture.end = end;
+
+        std::lock_guard lock(m_mutex);
+        capture.threads.reserve(m_threads.size());
+        for (const std::unique_ptr<ThreadProfile>& profile : m_threads) {
+            ProfileCapture::Thread thread;
+            thread.id = profile->get_id();
+            thread.name = profile->m_name;
+            thread.events = profile->snapshot(start);
+            std::erase_if(thread.events, [end](const ProfileEvent& event) { return event.start > end; });
+            capture.threads.push_back(std::move(thread));
+        }
+        return capture;
+    }
+
+    void Profiler::write_chrome_trace(const std::string& path) const {
+        ProfileCapture all = capture(0, UINT64_MAX);
+
+        std::ofstream file(path, std::ios::trunc);
+        if (!file.is_open()) {
+            throw ProfilerException("Failed to open trace file: " + path);
+        }
+
+        // Timestamps are microseconds relative to the oldest zone still recorded
+        uint64_t origin = UINT64_MAX;
+        for (const ProfileCapture::Thread& thread : all.threads) {
+            for (const ProfileEvent& event : thread.events) {
+                origin = std::min(origin, event.start);
+            }
+        }
+
+        file << "{\"traceEvents\":[\n";
+        bool first = true;
+        for (const ProfileCapture::Thread& thread : all.threads) {
+            file << (first ? "" : ",\n") << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << thread.id
+                 << ",\"args\":{\"name\":";
+            write_json_string(file, thread.name);
+            file << "}}";
+            first = false;
+
+            for (const ProfileEvent& event : thread.events) {
+                file << ",\n{\"name\":";
+                write_json_string(file, event.name);
+                file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << thread.id
+                     << ",\"ts\":" << static_cast<double>(event.start - origin) / 1000.0
+                     << ",\"dur\":" << static_cast<double>(event.end - event.start) / 1000.0 << "}";
+            }
+        }
+        file << "\n],\"displayTimeUnit\":\"ms\"}\n";
+
+        if (!file.good()) {
+            throw ProfilerException("Failed to write trace file: " + path);
+        }
+    }
+
+    void Profiler::draw_panel() {
+        if (!m_panelVisible) {
+            return;
+        }
+
+        if (!ImGui::Begin("Profiler", &m_panelVisible)) {
+            ImGui::End();
+            return;
+        }
+
+#ifndef MINECART_PROFILER
+        ImGui::TextUnformatted("Built without MINECART_PROFILER; rebuild with scons profile=1");
+#endif
+
+        bool enabled = is_enabled();
+        if (ImGui::Checkbox("Record", &enabled)) {
+            set_enabled(enabled);
+        }
+        ImGui::SameLine();
+        ImGui::Checkbox("Pause", &m_paused);
+        ImGui::SameLine();
+        if (ImGui::Button("Export trace")) {
+            try {
+                write_chrome_trace("minecart_trace.json");
+                spdlog::info("Wrote profiler trace to minecart_trace.json");
+            }
+            catch (const ProfilerException& e) {
+                spdlog::error("{}", e.what());
+            }
+        }
+
+        // Frame times of the recorded history, oldest first
+        std::array<float, FRAME_HISTORY> frameTimes{};
+        int frameTimeCount = 0;
+        for (uint32_t i = FRAME_HISTORY - 1; i > 0; --i) {
+            uint64_t start = get_frame_start(i);
+            uint64_t end = get_frame_start(i - 1);
+            if (start != 0 && end > start) {
+                frameTimes[frameTimeCount++] = static_cast<float>(end - start) * 1e-6f;
+            }
+        }
+        ImGui::PlotLines("Frame (ms)", frameTimes.data(), frameTimeCount, 0, nullptr, 0.0f, 33.3f, ImVec2(0.0f, 60.0f));
+
+        // Show the last complete frame unless paused
+        if (!m_paused) {
+            uint64_t start = get_frame_start(1);
+            uint64_t end = get_frame_start(0);
+            if (start != 0) {
+                m_shownFrame = capture(start, end);
+            }
+        }
+
+        if (m_shownFrame.end > m_shownFrame.start) {
+            ImGui::Text("Frame: %.3f ms", static_cast<double>(m_shownFrame.end - m_shownFrame.start) * 1e-6);
+            ImGui::Separator();
+            draw_timeline(m_shownFrame);
+            ImGui::Separator();
+            draw_zone_table(m_shownFrame);
+        }
+
+        ImGui::End();
+    }
+
+    void Profiler::draw_timeline(const ProfileCapture& frame) {
+        constexpr float ROW_HEIGHT = 18.0f;
+        const double frameLength = static_cast<double>(frame.end - frame.start);
+
+        for (const ProfileCapture::Thread& thread : frame.threads) {
+            if (thread.events.empty()) {
+                continue;
+            }
+
+            uint32_t maxDepth = 0;
+            for (const ProfileEvent& event : thread.events) {
+                maxDepth = std::max(maxDepth, event.depth);
+            }
+
+            ImGui::TextUnformatted(thread.name.c_str());
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+            const float width = std::max(ImGui::GetContentRegionAvail().x, 1.0f);
+            const float height = ROW_HEIGHT * static_cast<float>(maxDepth + 1);
+
+            ImDrawList* drawList = ImGui::GetWindowDrawList();
+            drawList->PushClipRect(origin, ImVec2(origin.x + width, origin.y + height), true);
+            for (const ProfileEvent& event : thread.events) {
+                // Zones straddling the frame boundary are clipped to it
+                uint64_t start = std::max(event.start, frame.start);
+                uint64_t end = std::min(event.end, frame.end);
+                float x0 = origin.x + static_cast<float>(static_cast<double>(start - frame.start) / frameLength) * width;
+                float x1 = origin.x + static_cast<float>(static_cast<double>(end - frame.start) / frameLength) * width;
+                float y0 = origin.y + ROW_HEIGHT * static_cast<float>(event.depth);
+                x1 = std::max(x1, x0 + 1.0f);
+
+                ImVec2 min(x0, y0);
+                ImVec2 max(x1, y0 + ROW_HEIGHT - 1.0f);
+                drawList->AddRectFilled(min, max, zone_color(event.name));
+                if (x1 - x0 > 40.0f) {
+                    drawList->PushClipRect(min, max, true);
+                    drawList->AddText(ImVec2(x0 + 3.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+                    drawList->PopClipRect();
+                }
+                if (ImGui::IsMouseHoveringRect(min, max)) {
+                    ImGui::SetTooltip("%s\n%.3f ms", event.name, static_cast<double>(event.end - event.start) * 1e-6);
+                }
+            }
+            drawList->PopClipRect();
+            ImGui::Dummy(ImVec2(width, height));
+        }
+    }
+
+    void Profiler::draw_zone_table(const ProfileCapture& frame) {
+        struct ZoneTotal {
+            const char* name;
+            uint32_t calls = 0;
+            uint64_t total = 0;
+        };
+
+        // Zones are keyed by name pointer; identical literals are usually merged
+        std::unordered_map<const char*, ZoneTotal> totals;
+        for (const ProfileCapture::Thread& thread : frame.threads) {
+            for (const ProfileEvent& event : thread.events) {
+                ZoneTotal& zone = totals.try_emplace(event.name, ZoneTotal{event.name}).first->second;
+                zone.calls++;
+                zone.total += event.end - event.start;
+            }
+        }
+
+        std::vector<ZoneTotal> sorted;
+        sorted.reserve(totals.size());
+        for (const auto& [name, zone] : totals) {
+            sorted.push_back(zone);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const ZoneTotal& a, const ZoneTotal& b) { return a.total > b.total; });
+
+        if (ImGui::BeginTable("ProfilerZones", 3, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit)) {
+            ImGui::TableSetupColumn("Zone");
+            ImGui::TableSetupColumn("Calls");
+            ImGui::TableSetupColumn("Total (ms)");
+            ImGui::TableHeadersRow();
+            for (const ZoneTotal& zone : sorted) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                ImGui::TextUnformatted(zone.name);
+                ImGui::TableNextColumn();
+                ImGui::Text("%u", zone.calls);
+                ImGui::TableNextColumn();
+                ImGui::Text("%.3f", static_cast<double>(zone.total) * 1e-6);
+            }
+            ImGui::EndTable();
+        }
+    }
+
+    // ------------------------------------------------------------------------
+    // ProfileScope
+    // ------------------------------------------------------------------------
+
+    ProfileScope::ProfileScope(const char* name) noexcept
+        : m_name(name)
+    {
+        Profiler& profiler = Profiler::get();
+        if (!profiler.is_enabled()) {
+            return;
+        }
+
+        // Registration allocates; a thread that cannot register simply goes unrecorded
+        try {
+            m_profile = &profiler.get_thread_profile();
+        }
+        catch (...) {
+            return;
+        }
+        m_profile->m_depth++;
+        m_start = SDL_GetTicksNS();
+    }
+
+    ProfileScope::~ProfileScope() {
+        if (!m_profile) {
+            return;
+        }
+        const uint64_t end = SDL_GetTicksNS();
+        m_profile->m_depth--;
+        m_profile->record(m_name, m_start, end, m_profile->m_depth);
+    }
+
+} // namespace minecart
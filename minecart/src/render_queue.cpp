@@ -0,0 +1,230 @@
+#include "minecart/render_queue.hpp"
+#include "minecart/gpu_stats.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+namespace minecart::graphics {
+
+    static constexpr uint32_t ID_BITS = 12;
+    static constexpr uint32_t ID_MASK = (1u << ID_BITS) - 1;
+    static constexpr uint32_t DEPTH_BITS = 24;
+    static constexpr uint32_t DEPTH_MASK = (1u << DEPTH_BITS) - 1;
+
+    uint64_t RenderQueue::make_sort_key(uint32_t pass, uint32_t pipeline, uint32_t material,
+                                        uint32_t buffer, float depth, DepthOrder order) noexcept {
+        // Non-negative floats order like their bit patterns; keep the top 24 bits
+        uint32_t depthBits = std::bit_cast<uint32_t>(std::max(depth, 0.0f)) >> (32 - DEPTH_BITS);
+        if (order == DepthOrder::BackToFront) {
+            depthBits = DEPTH_MASK - depthBits;
+        }
+
+        return (static_cast<uint64_t>(pass & 0xFu) << 60)
+             | (static_cast<uint64_t>(pipeline & ID_MASK) << 48)
+             | (static_cast<uint64_t>(material & ID_MASK) << 36)
+             | (static_cast<uint64_t>(buffer & ID_MASK) << 24)
+             | static_cast<uint64_t>(depthBits & DEPTH_MASK);
+    }
+
+    void RenderQueue::set_depth_order(uint32_t pass, DepthOrder order) {
+        m_depthOrder[pass % MAX_PASSES] = order;
+    }
+
+    uint32_t RenderQueue::intern(std::unordered_map<const void*, uint32_t>& ids, const void* object) {
+        auto [it, inserted] = ids.try_emplace(object, static_cast<uint32_t>(ids.size()));
+        return it->second;
+    }
+
+    uint32_t RenderQueue::store_uniforms(std::span<const std::byte> data) {
+        uint32_t offset = static_cast<uint32_t>(m_uniformData.size());
+        m_uniformData.insert(m_uniformData.end(), data.begin(), data.end());
+        return offset;
+    }
+
+    void RenderQueue::submit(const RenderCommand& command) {
+        if (!command.model || !command.pipeline || command.instanceCount == 0 || !command.model->is_ready()) {
+            return;
+        }
+
+        Item item;
+        item.pipeline = command.pipeline;
+        item.draw = command.model->get_draw_info();
+        item.material = command.material;
+        item.instanceCount = command.instanceCount;
+        item.firstInstance = command.firstInstance;
+        item.vertexUniformOffset = store_uniforms(command.vertexUniforms);
+        item.vertexUniformSize = static_cast<uint32_t>(command.vertexUniforms.size());
+        item.fragmentUniformOffset = store_uniforms(command.fragmentUniforms);
+        item.fragmentUniformSize = static_cast<uint32_t>(command.fragmentUniforms.size());
+
+        uint32_t pass = command.pass % MAX_PASSES;
+        m_keys.push_back(make_sort_key(pass,
+                                       intern(m_pipelineIds, command.pipeline),
+                                       command.material,
+                                       intern(m_bufferIds, item.draw.vertexBuffer),
+                                       command.depth,
+                                       m_depthOrder[pass]));
+        m_items.push_back(item);
+    }
+
+    void RenderQueue::sort() {
+        size_t count = m_keys.size();
+        m_order.resize(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            m_order[i] = i;
+        }
+        m_scratchKeys.resize(count);
+        m_scratchOrder.resize(count);
+
+        // LSD radix sort, 8 bits per pass; stable, so equal keys keep submission order
+        std::vector<uint64_t>& keys = m_keys;
+        for (uint32_t shift = 0; shift < 64; shift += 8) {
+            std::array<uint32_t, 256> histogram{};
+            for (uint64_t key : keys) {
+                histogram[(key >> shift) & 0xFF]++;
+            }
+            if (histogram[(keys[0] >> shift) & 0xFF] == count) {
+                continue; // Every key has the same digit here
+            }
+
+            uint32_t sum = 0;
+            for (uint32_t& bucket : histogram) {
+                uint32_t bucketCount = bucket;
+                bucket = sum;
+                sum += bucketCount;
+            }
+            for (size_t i = 0; i < count; ++i) {
+                uint32_t destination = histogram[(keys[i] >> shift) & 0xFF]++;
+                m_scratchKeys[destination] = keys[i];
+                m_scratchOrder[destination] = m_order[i];
+            }
+            std::swap(keys, m_scratchKeys);
+            std::swap(m_order, m_scratchOrder);
+        }
+    }
+
+    void RenderQueue::execute(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass) {
+        m_stats = RenderQueueStats{};
+        m_stats.items = static_cast<uint32_t>(m_items.size());
+        if (m_items.empty()) {
+            clear();
+            return;
+        }
+
+        sort();
+
+        SDL_GPUGraphicsPipeline* currentPipeline = nullptr;
+        SDL_GPUBuffer* currentVertexBuffer = nullptr;
+        SDL_GPUBuffer* currentIndexBuffer = nullptr;
+        SDL_GPUIndexElementSize currentIndexSize = SDL_GPU_INDEXELEMENTSIZE_32BIT;
+        const Item* lastVertexUniforms = nullptr;
+        const Item* lastFragmentUniforms = nullptr;
+        bool hasMaterial = false;
+        uint32_t currentMaterial = 0;
+
+        auto sameBytes = [this](const Item* last, uint32_t offset, uint32_t size, bool fragment) {
+            if (!last) {
+                return false;
+            }
+            uint32_t lastOffset = fragment ? last->fragmentUniformOffset : last->vertexUniformOffset;
+            uint32_t lastSize = fragment ? last->fragmentUniformSize : last->vertexUniformSize;
+            return lastSize == size && std::memcmp(m_uniformData.data() + lastOffset, m_uniformData.data() + offset, size) == 0;
+        };
+
+        for (uint32_t index : m_order) {
+            const Item& item = m_items[index];
+
+            if (item.pipeline != currentPipeline) {
+                SDL_BindGPUGraphicsPipeline(renderPass, item.pipeline);
+                GpuStats::get().add_pipeline_bind();
+                currentPipeline = item.pipeline;
+                m_stats.bindsIssued++;
+
+                // Pipelines may declare different resource layouts; re-send material and uniforms
+                lastVertexUniforms = nullptr;
+                lastFragmentUniforms = nullptr;
+                hasMaterial = false;
+            } else {
+                m_stats.bindsSkipped++;
+            }
+
+            if (!hasMaterial || item.material != currentMaterial) {
+                if (m_materialBinder) {
+                    m_materialBinder(commandBuffer, renderPass, item.material);
+                    m_stats.bindsIssued++;
+                }
+                currentMaterial = item.material;
+                hasMaterial = true;
+            } else if (m_materialBinder) {
+                m_stats.bindsSkipped++;
+            }
+
+            if (item.vertexUniformSize > 0) {
+                if (!sameBytes(lastVertexUniforms, item.vertexUniformOffset, item.vertexUniformSize, false)) {
+                    SDL_PushGPUVertexUniformData(commandBuffer, 0, m_uniformData.data() + item.vertexUniformOffset, item.vertexUniformSize);
+                    GpuStats::get().add_uniform_push(item.vertexUniformSize);
+                    lastVertexUniforms = &item;
+                    m_stats.bindsIssued++;
+                } else {
+                    m_stats.bindsSkipped++;
+                }
+            }
+            if (item.fragmentUniformSize > 0) {
+                if (!sameBytes(lastFragmentUniforms, item.fragmentUniformOffset, item.fragmentUniformSize, true)) {
+                    SDL_PushGPUFragmentUniformData(commandBuffer, 0, m_uniformData.data() + item.fragmentUniformOffset, item.fragmentUniformSize);
+                    GpuStats::get().add_uniform_push(item.fragmentUniformSize);
+                    lastFragmentUniforms = &item;
+                    m_stats.bindsIssued++;
+                } else {
+                    m_stats.bindsSkipped++;
+                }
+            }
+
+            const ModelDrawInfo& draw = item.draw;
+            if (draw.vertexBuffer != currentVertexBuffer) {
+                SDL_GPUBufferBinding vertexBufferBinding{};
+                vertexBufferBinding.buffer = draw.vertexBuffer;
+                vertexBufferBinding.offset = 0;
+                SDL_BindGPUVertexBuffers(renderPass, 0, &vertexBufferBinding, 1);
+                GpuStats::get().add_buffer_binds(1);
+                currentVertexBuffer = draw.vertexBuffer;
+                m_stats.bindsIssued++;
+            } else {
+                m_stats.bindsSkipped++;
+            }
+
+            if (draw.indexBuffer) {
+                if (draw.indexBuffer != currentIndexBuffer || draw.indexElementSize != currentIndexSize) {
+                    SDL_GPUBufferBinding indexBufferBinding{};
+                    indexBufferBinding.buffer = draw.indexBuffer;
+                    indexBufferBinding.offset = 0;
+                    SDL_BindGPUIndexBuffer(renderPass, &indexBufferBinding, draw.indexElementSize);
+                    GpuStats::get().add_buffer_binds(1);
+                    currentIndexBuffer = draw.indexBuffer;
+                    currentIndexSize = draw.indexElementSize;
+                    m_stats.bindsIssued++;
+                } else {
+                    m_stats.bindsSkipped++;
+                }
+                SDL_DrawGPUIndexedPrimitives(renderPass, draw.count, item.instanceCount, draw.first, draw.baseVertex, item.firstInstance);
+            } else {
+                SDL_DrawGPUPrimitives(renderPass, draw.count, item.instanceCount, draw.first, item.firstInstance);
+            }
+            m_stats.drawCalls++;
+            GpuStats::get().add_draw(draw.count, item.instanceCount);
+        }
+
+        clear();
+    }
+
+    void RenderQueue::clear() {
+        m_items.clear();
+        m_keys.clear();
+        m_order.clear();
+        m_uniformData.clear();
+        m_pipelineIds.clear();
+        m_bufferIds.clear();
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,524 @@
+#include "minecart/scene_index.hpp"
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <utility>
+
+namespace minecart::graphics {
+
+    namespace {
+
+        constexpr uint32_t BIN_COUNT = 12;
+        constexpr float TRAVERSAL_COST = 1.0f;  // Relative to one object test
+
+        // Half the surface area; only ratios matter for the SAH
+        float half_area(const Aabb& box) noexcept {
+            if (box.is_empty()) {
+                return 0.0f;
+            }
+            glm::vec3 d = box.max - box.min;
+            return d.x * d.y + d.y * d.z + d.z * d.x;
+        }
+
+        // Entry distance of a ray into a box, or a negative value on a miss
+        float intersect_ray(const Aabb& box, const glm::vec3& origin, const glm::vec3& inverseDirection, float maxDistance) noexcept {
+            float tmin = 0.0f;
+            float tmax = maxDistance;
+            for (int axis = 0; axis < 3; ++axis) {
+                float t1 = (box.min[axis] - origin[axis]) * inverseDirection[axis];
+                float t2 = (box.max[axis] - origin[axis]) * inverseDirection[axis];
+                tmin = std::max(tmin, std::min(t1, t2));
+                tmax = std::min(tmax, std::max(t1, t2));
+            }
+            return tmin <= tmax ? tmin : -1.0f;
+        }
+
+        glm::vec3 inverse_direction(const glm::vec3& direction) noexcept {
+            constexpr float huge = std::numeric_limits<float>::max();
+            return glm::vec3{
+                direction.x != 0.0f ? 1.0f / direction.x : huge,
+                direction.y != 0.0f ? 1.0f / direction.y : huge,
+                direction.z != 0.0f ? 1.0f / direction.z : huge};
+        }
+
+        float distance_squared(const Aabb& box, const glm::vec3& point) noexcept {
+            float result = 0.0f;
+            for (int axis = 0; axis < 3; ++axis) {
+                float d = std::max({box.min[axis] - point[axis], 0.0f, point[axis] - box.max[axis]});
+                result += d * d;
+            }
+            return result;
+        }
+
+        enum class Containment { Outside, Intersecting, Inside };
+
+        Containment classify(const Frustum& frustum, const Aabb& box) noexcept {
+            if (box.is_empty()) {
+                return Containment::Outside;
+            }
+            glm::vec3 center = box.get_center();
+            glm::vec3 extents = box.get_extents();
+            Containment result = Containment::Inside;
+            for (const glm::vec4& plane : frustum.planes) {
+                float distance = plane.x * center.x + plane.y * center.y + plane.z * center.z + plane.w;
+                float radius = std::abs(plane.x) * extents.x + std::abs(plane.y) * extents.y + std::abs(plane.z) * extents.z;
+                if (distance + radius < 0.0f) {
+                    return Containment::Outside;
+                }
+                if (distance - radius < 0.0f) {
+                    result = Containment::Intersecting;
+                }
+            }
+            return result;
+        }
+
+        double elapsed_ms(Uint64 start) {
+            return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0
+                / static_cast<double>(SDL_GetPerformanceFrequency());
+        }
+
+    } // namespace
+
+    Aabb transform_bounds(const Aabb& box, const glm::mat4& transform) {
+        if (box.is_empty()) {
+            return box;
+        }
+
+        // Arvo's method: each output axis is the translation plus the extreme
+        // contributions of every input axis
+        Aabb result;
+        result.min = glm::vec3{transform[3].x, transform[3].y, transform[3].z};
+        result.max = result.min;
+        for (int column = 0; column < 3; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                float a = transform[column][row] * box.min[column];
+                float b = transform[column][row] * box.max[column];
+                result.min[row] += std::min(a, b);
+                result.max[row] += std::max(a, b);
+            }
+        }
+        return result;
+    }
+
+    uint32_t SceneIndex::insert(const Aabb& bounds) {
+        uint32_t object;
+        if (!m_freeObjects.empty()) {
+            object = m_freeObjects.back();
+            m_freeObjects.pop_back();
+        } else {
+            object = static_cast<uint32_t>(m_objects.size());
+            m_objects.emplace_back();
+        }
+        m_objects[object].bounds = bounds;
+        m_objects[object].live = true;
+        m_liveObjects++;
+        m_structureDirty = true;
+        return object;
+    }
+
+    void SceneIndex::update(uint32_t object, const Aabb& bounds) {
+        if (object >= m_objects.size() || !m_objects[object].live) {
+            return;
+        }
+        m_objects[object].bounds = bounds;
+        m_boundsDirty = true;
+    }
+
+    void SceneIndex::remove(uint32_t object) {
+        if (object >= m_objects.size() || !m_objects[object].live) {
+            return;
+        }
+        m_objects[object] = Object{};
+        m_freeObjects.push_back(object);
+        m_liveObjects--;
+        m_structureDirty = true;
+    }
+
+    void SceneIndex::clear() {
+        m_objects.clear();
+        m_freeObjects.clear();
+        m_nodes.clear();
+        m_leafObjects.clear();
+        m_liveObjects = 0;
+        m_depth = 0;
+        m_sahCost = 0.0f;
+        m_builtSahCost = 0.0f;
+        m_structureDirty = false;
+        m_boundsDirty = false;
+    }
+
+    void SceneIndex::commit() {
+        if (m_structureDirty) {
+            build();
+            return;
+        }
+        if (m_boundsDirty) {
+            refit();
+            if (m_sahCost > m_builtSahCost * m_rebuildThreshold) {
+                build();
+            }
+        }
+    }
+
+    void SceneIndex::build() {
+        Uint64 start = SDL_GetPerformanceCounter();
+
+        m_nodes.clear();
+        m_leafObjects.clear();
+        m_leafObjects.reserve(m_liveObjects);
+
+        std::vector<glm::vec3> centroids(m_objects.size());
+        for (uint32_t i = 0; i < m_objects.size(); ++i) {
+            if (m_objects[i].live) {
+                m_leafObjects.push_back(i);
+                centroids[i] = m_objects[i].bounds.get_center();
+            }
+        }
+
+        m_depth = 0;
+        if (!m_leafObjects.empty()) {
+            // A binary tree over n leaves has at most 2n - 1 nodes
+            m_nodes.reserve(m_leafObjects.size() * 2);
+
+            Node root;
+            root.first = 0;
+            root.count = static_cast<uint32_t>(m_leafObjects.size());
+            for (uint32_t object : m_leafObjects) {
+                root.bounds.expand(m_objects[object].bounds);
+            }
+            m_nodes.push_back(root);
+
+            std::vector<std::pair<uint32_t, uint32_t>> stack{{0u, 1u}};
+            while (!stack.empty()) {
+                auto [node, depth] = stack.back();
+                stack.pop_back();
+                m_depth = std::max(m_depth, depth);
+                if (split_node(node, centroids)) {
+                    stack.emplace_back(m_nodes[node].first, depth + 1);
+                    stack.emplace_back(m_nodes[node].first + 1, depth + 1);
+                }
+            }
+        }
+
+        m_sahCost = compute_sah_cost();
+        m_builtSahCost = m_sahCost;
+        m_structureDirty = false;
+        m_boundsDirty = false;
+        m_builds++;
+        m_lastBuildMs = elapsed_ms(start);
+    }
+
+    bool SceneIndex::split_node(uint32_t nodeIndex, const std::vector<glm::vec3>& centroids) {
+        const uint32_t first = m_nodes[nodeIndex].first;
+        const uint32_t count = m_nodes[nodeIndex].count;
+        if (count <= 1) {
+            return false;
+        }
+        auto begin = m_leafObjects.begin() + first;
+        auto end = begin + count;
+
+        Aabb centroidBounds;
+        for (auto it = begin; it != end; ++it) {
+            centroidBounds.expand(centroids[*it]);
+        }
+
+        // Evaluate BIN_COUNT - 1 candidate planes on each axis
+        float bestCost = std::numeric_limits<float>::max();
+        int bestAxis = -1;
+        uint32_t bestSplit = 0;
+        for (int axis = 0; axis < 3; ++axis) {
+            float lo = centroidBounds.min[axis];
+            float extent = centroidBounds.max[axis] - lo;
+            if (!(extent > 0.0f)) {
+                continue;
+            }
+            float scale = BIN_COUNT / extent;
+
+            std::array<Aabb, BIN_COUNT> binBounds{};
+            std::array<uint32_t, BIN_COUNT> binCounts{};
+            for (auto it = begin; it != end; ++it) {
+                uint32_t bin = std::min(BIN_COUNT - 1, static_cast<uint32_t>((centroids[*it][axis] - lo) * scale));
+                binBounds[bin].expand(m_objects[*it].bounds);
+                binCounts[bin]++;
+            }
+
+            // Sweep from the right to get the cost of everything above each plane
+            std::array<float, BIN_COUNT> rightCost{};
+            Aabb rightBounds;
+            uint32_t rightCount = 0;
+            for (uint32_t i = BIN_COUNT - 1; i > 0; --i) {
+                rightBounds.expand(binBounds[i]);
+                rightCount += binCounts[i];
+                rightCost[i] = rightCount * half_area(rightBounds);
+            }
+
+            Aabb leftBounds;
+            uint32_t leftCount = 0;
+            for (uint32_t i = 0; i < BIN_COUNT - 1; ++i) {
+                leftBounds.expand(binBounds[i]);
+                leftCount += binCounts[i];
+                if (leftCount == 0 || leftCount == count) {
+                    continue;
+                }
+                float cost = leftCount * half_area(leftBounds) + rightCost[i + 1];
+                if (cost < bestCost) {
+                    bestCost = cost;
+                    bestAxis = axis;
+                    bestSplit = i + 1;
+                }
+            }
+        }
+
+        const Aabb nodeBounds = m_nodes[nodeIndex].bounds;
+        float leafCost = count * half_area(nodeBounds);
+        float splitCost = TRAVERSAL_COST * half_area(nodeBounds) + bestCost;
+        if (count <= MAX_LEAF_OBJECTS && (bestAxis < 0 || splitCost >= leafCost)) {
+            return false;
+        }
+
+        uint32_t leftCount;
+        if (bestAxis >= 0) {
+            float lo = centroidBounds.min[bestAxis];
+            float scale = BIN_COUNT / (centroidBounds.max[bestAxis] - lo);
+            auto middle = std::partition(begin, end, [&](uint32_t object) {
+                uint32_t bin = std::min(BIN_COUNT - 1, static_cast<uint32_t>((centroids[object][bestAxis] - lo) * scale));
+                return bin < bestSplit;
+            });
+            leftCount = static_cast<uint32_t>(middle - begin);
+        } else {
+            // Every centroid coincides; split in half to keep leaves small
+            leftCount = count / 2;
+        }
+
+        Node left;
+        left.first = first;
+        left.count = leftCount;
+        Node right;
+        right.first = first + leftCount;
+        right.count = count - leftCount;
+        for (uint32_t i = left.first; i < left.first + left.count; ++i) {
+            left.bounds.expand(m_objects[m_leafObjects[i]].bounds);
+        }
+        for (uint32_t i = right.first; i < right.first + right.count; ++i) {
+            right.bounds.expand(m_objects[m_leafObjects[i]].bounds);
+        }
+
+        uint32_t childIndex = static_cast<uint32_t>(m_nodes.size());
+        m_nodes.push_back(left);
+        m_nodes.push_back(right);
+        m_nodes[nodeIndex].first = childIndex;
+        m_nodes[nodeIndex].count = 0;
+        return true;
+    }
+
+    void SceneIndex::refit() {
+        Uint64 start = SDL_GetPerformanceCounter();
+
+        // Children are always stored after their parent, so one reverse pass is bottom-up
+        for (size_t i = m_nodes.size(); i-- > 0;) {
+            Node& node = m_nodes[i];
+            Aabb bounds;
+            if (node.count > 0) {
+                for (uint32_t j = node.first; j < node.first + node.count; ++j) {
+                    const Object& object = m_objects[m_leafObjects[j]];
+                    if (object.live) {
+                        bounds.expand(object.bounds);
+                    }
+                }
+            } else {
+                bounds = m_nodes[node.first].bounds;
+                bounds.expand(m_nodes[node.first + 1].bounds);
+            }
+            node.bounds = bounds;
+        }
+
+        m_sahCost = compute_sah_cost();
+        m_boundsDirty = false;
+        m_refits++;
+        m_lastRefitMs = elapsed_ms(start);
+    }
+
+    float SceneIndex::compute_sah_cost() const {
+        if (m_nodes.empty()) {
+            return 0.0f;
+        }
+        float rootArea = half_area(m_nodes[0].bounds);
+        if (!(rootArea > 0.0f)) {
+            return 0.0f;
+        }
+
+        float cost = 0.0f;
+        for (const Node& node : m_nodes) {
+            float area = half_area(node.bounds);
+            cost += node.count > 0 ? area * node.count : area * TRAVERSAL_COST;
+        }
+        return cost / rootArea;
+    }
+
+    void SceneIndex::query_frustum(const Frustum& frustum, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        // Subtrees fully inside the frustum are collected without further plane tests
+        std::vector<std::pair<uint32_t, bool>> stack{{0u, false}};
+        while (!stack.empty()) {
+            auto [index, inside] = stack.back();
+            stack.pop_back();
+            const Node& node = m_nodes[index];
+
+            if (!inside) {
+                Containment containment = classify(frustum, node.bounds);
+                if (containment == Containment::Outside) {
+                    continue;
+                }
+                inside = containment == Containment::Inside;
+            }
+
+            if (node.count == 0) {
+                stack.emplace_back(node.first, inside);
+                stack.emplace_back(node.first + 1, inside);
+                continue;
+            }
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t object = m_leafObjects[i];
+                if (m_objects[object].live && (inside || frustum.intersects(m_objects[object].bounds))) {
+                    out.push_back(object);
+                }
+            }
+        }
+    }
+
+    void SceneIndex::query_radius(const glm::vec3& center, float radius, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        const float radiusSquared = radius * radius;
+        std::vector<uint32_t> stack{0u};
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (distance_squared(node.bounds, center) > radiusSquared) {
+                continue;
+            }
+
+            if (node.count == 0) {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+                continue;
+            }
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t object = m_leafObjects[i];
+                if (m_objects[object].live && distance_squared(m_objects[object].bounds, center) <= radiusSquared) {
+                    out.push_back(object);
+                }
+            }
+        }
+    }
+
+    void SceneIndex::query_ray(const glm::vec3& origin, const glm::vec3& direction, float maxDistance, std::vector<uint32_t>& out) const {
+        out.clear();
+        if (m_nodes.empty()) {
+            return;
+        }
+
+        const glm::vec3 inverse = inverse_direction(direction);
+        std::vector<uint32_t> stack{0u};
+        while (!stack.empty()) {
+            const Node& node = m_nodes[stack.back()];
+            stack.pop_back();
+            if (intersect_ray(node.bounds, origin, inverse, maxDistance) < 0.0f) {
+                continue;
+            }
+
+            if (node.count == 0) {
+                stack.push_back(node.first);
+                stack.push_back(node.first + 1);
+                continue;
+            }
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t object = m_leafObjects[i];
+                if (m_objects[object].live && intersect_ray(m_objects[object].bounds, origin, inverse, maxDistance) >= 0.0f) {
+                    out.push_back(object);
+                }
+            }
+        }
+    }
+
+    std::optional<SceneRayHit> SceneIndex::raycast(const glm::vec3& origin, const glm::vec3& direction, float maxDistance) const {
+        if (m_nodes.empty()) {
+            return std::nullopt;
+        }
+
+        const glm::vec3 inverse = inverse_direction(direction);
+        std::optional<SceneRayHit> closest;
+        float limit = maxDistance;
+
+        // Visit the nearer child first so later subtrees can be pruned by the closest hit
+        std::vector<std::pair<uint32_t, float>> stack;
+        float rootDistance = intersect_ray(m_nodes[0].bounds, origin, inverse, limit);
+        if (rootDistance >= 0.0f) {
+            stack.emplace_back(0u, rootDistance);
+        }
+        while (!stack.empty()) {
+            auto [index, entry] = stack.back();
+            stack.pop_back();
+            if (entry > limit) {
+                continue;
+            }
+            const Node& node = m_nodes[index];
+
+            if (node.count == 0) {
+                float leftDistance = intersect_ray(m_nodes[node.first].bounds, origin, inverse, limit);
+                float rightDistance = intersect_ray(m_nodes[node.first + 1].bounds, origin, inverse, limit);
+                std::pair<uint32_t, float> left{node.first, leftDistance};
+                std::pair<uint32_t, float> right{node.first + 1, rightDistance};
+                if (leftDistance > rightDistance) {
+                    std::swap(left, right);
+                }
+                // Push the farther child first so the nearer one is popped next
+                if (right.second >= 0.0f) {
+                    stack.push_back(right);
+                }
+                if (left.second >= 0.0f) {
+                    stack.push_back(left);
+                }
+                continue;
+            }
+            for (uint32_t i = node.first; i < node.first + node.count; ++i) {
+                uint32_t object = m_leafObjects[i];
+                if (!m_objects[object].live) {
+                    continue;
+                }
+                float distance = intersect_ray(m_objects[object].bounds, origin, inverse, limit);
+                if (distance >= 0.0f && (!closest || distance < closest->distance)) {
+                    closest = SceneRayHit{object, distance};
+                    limit = distance;
+                }
+            }
+        }
+        return closest;
+    }
+
+    SceneIndexStats SceneIndex::get_stats() const noexcept {
+        SceneIndexStats stats;
+        stats.objects = m_liveObjects;
+        stats.nodes = static_cast<uint32_t>(m_nodes.size());
+        stats.depth = m_depth;
+        stats.sahCost = m_sahCost;
+        stats.builtSahCost = m_builtSahCost;
+        stats.builds = m_builds;
+        stats.refits = m_refits;
+        stats.lastBuildMs = m_lastBuildMs;
+        stats.lastRefitMs = m_lastRefitMs;
+        return stats;
+    }
+
+} // namespace minecart::graphics
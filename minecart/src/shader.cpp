@@ -1,9 +1,11 @@
 #include "minecart/shader.hpp"
+#include "minecart/shader_cache.hpp"
 
 #include <SDL3_shadercross/SDL_shadercross.h>
 #include <spdlog/spdlog.h>
 
 #include <vector>
+#include <mutex>
 #include <fstream>
 #include <sstream>
 
@@ -20,41 +22,63 @@ namespace minecart::graphics {
         return buffer.str();
     }
 
-    Shader::Shader(SDL_GPUDevice* device, SDL_Window* window)
-        : m_device(device)
-        , m_window(window)
-        , m_vertexShader(nullptr, SDLGPUShaderDeleter{device})
-        , m_fragmentShader(nullptr, SDLGPUShaderDeleter{device})
-    {
-        if (!device) {
-            throw ShaderException("Device cannot be null");
-        }
-        if (!window) {
-            throw ShaderException("Window cannot be null");
-        }
+    static const char* stage_name(SDL_GPUShaderStage stage) {
+        return stage == SDL_GPU_SHADERSTAGE_VERTEX ? "vertex" : "fragment";
+    }
 
-        // Initialize SDL_shadercross
-        if (!SDL_ShaderCross_Init()) {
-            throw ShaderException("Failed to initialize SDL_shadercross");
-        }
+    static SDL_ShaderCross_ShaderStage to_shadercross_stage(SDL_GPUShaderStage stage) {
+        return stage == SDL_GPU_SHADERSTAGE_VERTEX ? SDL_SHADERCROSS_SHADERSTAGE_VERTEX : SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT;
+    }
+
+    void initialize_shadercross() {
+        // A failed attempt throws out of call_once, leaving the next call to retry
+        static std::once_flag once;
+        std::call_once(once, [] {
+            if (!SDL_ShaderCross_Init()) {
+                throw ShaderException("Failed to initialize SDL_shadercross");
+            }
+        });
     }
 
-    void Shader::load_vertex_shader(const std::filesystem::path& path, const char* entrypoint) {
-        std::string source = read_file_contents(path);
+    CompiledShader compile_shader(const ShaderSourceDesc& desc, ShaderCache* cache) {
+        const uint64_t start = SDL_GetTicksNS();
+        std::string source = read_file_contents(desc.path);
+
+        CompiledShader compiled;
+        uint64_t key = 0;
+        if (cache) {
+            key = ShaderCache::compute_key(desc, source);
+            if (cache->load(key, desc, compiled)) {
+                compiled.timeNS = SDL_GetTicksNS() - start;
+                cache->record(compiled);
+                spdlog::debug("Shader '{}' loaded from cache in {:.2f} ms", desc.path.string(), compiled.timeNS * 1e-6);
+                return compiled;
+            }
+        }
+
+        // SDL_shadercross expects a define list terminated by a null name
+        std::vector<SDL_ShaderCross_HLSL_Define> defines;
+        for (const ShaderDefine& define : desc.defines) {
+            defines.push_back(SDL_ShaderCross_HLSL_Define{
+                const_cast<char*>(define.name.c_str()),
+                define.value.empty() ? nullptr : const_cast<char*>(define.value.c_str())});
+        }
+        defines.push_back(SDL_ShaderCross_HLSL_Define{nullptr, nullptr});
 
         // Compile HLSL to SPIR-V
+        const std::string includeDir = desc.path.parent_path().string();
         SDL_ShaderCross_HLSL_Info hlslInfo{};
         hlslInfo.source = source.c_str();
-        hlslInfo.entrypoint = entrypoint;
-        hlslInfo.shader_stage = SDL_SHADERCROSS_SHADERSTAGE_VERTEX;
-        hlslInfo.include_dir = path.parent_path().string().c_str();
-        hlslInfo.defines = nullptr;
+        hlslInfo.entrypoint = desc.entrypoint.c_str();
+        hlslInfo.shader_stage = to_shadercross_stage(desc.stage);
+        hlslInfo.include_dir = includeDir.c_str();
+        hlslInfo.defines = desc.defines.empty() ? nullptr : defines.data();
         hlslInfo.props = 0;
 
         size_t spirvSize = 0;
         void* spirvCode = SDL_ShaderCross_CompileSPIRVFromHLSL(&hlslInfo, &spirvSize);
         if (!spirvCode) {
-            throw ShaderException(std::string("Failed to compile vertex shader: ") + SDL_GetError());
+            throw ShaderException(std::string("Failed to compile ") + stage_name(desc.stage) + " shader: " + SDL_GetError());
         }
 
         // Reflect shader to get resource info
@@ -62,94 +86,129 @@ namespace minecart::graphics {
             static_cast<const Uint8*>(spirvCode), spirvSize, 0);
         if (!metadata) {
             SDL_free(spirvCode);
-            throw ShaderException(std::string("Failed to reflect vertex shader: ") + SDL_GetError());
+            throw ShaderException(std::string("Failed to reflect ") + stage_name(desc.stage) + " shader: " + SDL_GetError());
         }
 
-        // Create GPU shader from SPIR-V
-        SDL_ShaderCross_SPIRV_Info spirvInfo{};
-        spirvInfo.bytecode = static_cast<const Uint8*>(spirvCode);
-        spirvInfo.bytecode_size = spirvSize;
-        spirvInfo.entrypoint = entrypoint;
-        spirvInfo.shader_stage = SDL_SHADERCROSS_SHADERSTAGE_VERTEX;
-        spirvInfo.props = 0;
+        // Log resource info for debugging
+        if (desc.stage == SDL_GPU_SHADERSTAGE_FRAGMENT) {
+            spdlog::debug("Fragment shader '{}' resources: samplers={}, storage_textures={}, storage_buffers={}, uniform_buffers={}",
+                desc.path.string(),
+                metadata->resource_info.num_samplers,
+                metadata->resource_info.num_storage_textures,
+                metadata->resource_info.num_storage_buffers,
+                metadata->resource_info.num_uniform_buffers);
+        }
 
-        SDL_GPUShader* shader = SDL_ShaderCross_CompileGraphicsShaderFromSPIRV(
-            m_device, &spirvInfo, &metadata->resource_info, 0);
+        const auto* bytes = static_cast<const uint8_t*>(spirvCode);
+        compiled.spirv.assign(bytes, bytes + spirvSize);
+        compiled.resources.numSamplers = metadata->resource_info.num_samplers;
+        compiled.resources.numStorageTextures = metadata->resource_info.num_storage_textures;
+        compiled.resources.numStorageBuffers = metadata->resource_info.num_storage_buffers;
+        compiled.resources.numUniformBuffers = metadata->resource_info.num_uniform_buffers;
+        compiled.entrypoint = desc.entrypoint;
+        compiled.stage = desc.stage;
 
         SDL_free(metadata);
         SDL_free(spirvCode);
 
-        if (!shader) {
-            throw ShaderException(std::string("Failed to create vertex shader: ") + SDL_GetError());
+        compiled.timeNS = SDL_GetTicksNS() - start;
+        if (cache) {
+            cache->store(key, compiled);
+            cache->record(compiled);
         }
-        m_vertexShader.reset(shader);
+        spdlog::debug("Shader '{}' compiled in {:.2f} ms", desc.path.string(), compiled.timeNS * 1e-6);
+        return compiled;
     }
 
-    void Shader::load_fragment_shader(const std::filesystem::path& path, const char* entrypoint) {
-        std::string source = read_file_contents(path);
+    GPUShaderPtr create_gpu_shader(SDL_GPUDevice* device, const CompiledShader& shader) {
+        if (!device) {
+            throw ShaderException("Device cannot be null");
+        }
 
-        // Compile HLSL to SPIR-V
-        SDL_ShaderCross_HLSL_Info hlslInfo{};
-        hlslInfo.source = source.c_str();
-        hlslInfo.entrypoint = entrypoint;
-        hlslInfo.shader_stage = SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT;
-        hlslInfo.include_dir = path.parent_path().string().c_str();
-        hlslInfo.defines = nullptr;
-        hlslInfo.props = 0;
+        SDL_GPUShader* gpuShader = nullptr;
+        if (SDL_GetGPUShaderFormats(device) & SDL_GPU_SHADERFORMAT_SPIRV) {
+            SDL_GPUShaderCreateInfo createInfo{};
+            createInfo.code = shader.spirv.data();
+            createInfo.code_size = shader.spirv.size();
+            createInfo.entrypoint = shader.entrypoint.c_str();
+            createInfo.format = SDL_GPU_SHADERFORMAT_SPIRV;
+            createInfo.stage = shader.stage;
+            createInfo.num_samplers = shader.resources.numSamplers;
+            createInfo.num_storage_textures = shader.resources.numStorageTextures;
+            createInfo.num_storage_buffers = shader.resources.numStorageBuffers;
+            createInfo.num_uniform_buffers = shader.resources.numUniformBuffers;
+            gpuShader = SDL_CreateGPUShader(device, &createInfo);
+        } else {
+            SDL_ShaderCross_SPIRV_Info spirvInfo{};
+            spirvInfo.bytecode = shader.spirv.data();
+            spirvInfo.bytecode_size = shader.spirv.size();
+            spirvInfo.entrypoint = shader.entrypoint.c_str();
+            spirvInfo.shader_stage = to_shadercross_stage(shader.stage);
+            spirvInfo.props = 0;
+
+            SDL_ShaderCross_GraphicsShaderResourceInfo resourceInfo{};
+            resourceInfo.num_samplers = shader.resources.numSamplers;
+            resourceInfo.num_storage_textures = shader.resources.numStorageTextures;
+            resourceInfo.num_storage_buffers = shader.resources.numStorageBuffers;
+            resourceInfo.num_uniform_buffers = shader.resources.numUniformBuffers;
+            gpuShader = SDL_ShaderCross_CompileGraphicsShaderFromSPIRV(device, &spirvInfo, &resourceInfo, 0);
+        }
 
-        size_t spirvSize = 0;
-        void* spirvCode = SDL_ShaderCross_CompileSPIRVFromHLSL(&hlslInfo, &spirvSize);
-        if (!spirvCode) {
-            throw ShaderException(std::string("Failed to compile fragment shader: ") + SDL_GetError());
+        if (!gpuShader) {
+            throw ShaderException(std::string("Failed to create ") + stage_name(shader.stage) + " shader: " + SDL_GetError());
         }
+        GpuStats::get().track_shader(gpuShader, shader.spirv.size());
+        return GPUShaderPtr(gpuShader, SDLGPUShaderDeleter{device});
+    }
 
-        // Reflect shader to get resource info
-        SDL_ShaderCross_GraphicsShaderMetadata* metadata = SDL_ShaderCross_ReflectGraphicsSPIRV(
-            static_cast<const Uint8*>(spirvCode), spirvSize, 0);
-        if (!metadata) {
-            SDL_free(spirvCode);
-            throw ShaderException(std::string("Failed to reflect fragment shader: ") + SDL_GetError());
+    Shader::Shader(SDL_GPUDevice* device, SDL_Window* window, ShaderCache* cache)
+        : m_device(device)
+        , m_window(window)
+        , m_cache(cache)
+        , m_vertexShader(nullptr, SDLGPUShaderDeleter{device})
+        , m_fragmentShader(nullptr, SDLGPUShaderDeleter{device})
+    {
+        if (!device) {
+            throw ShaderException("Device cannot be null");
+        }
+        if (!window) {
+            throw ShaderException("Window cannot be null");
         }
 
-        // Log resource info for debugging
-        spdlog::info("Fragment shader '{}' resources: samplers={}, storage_textures={}, storage_buffers={}, uniform_buffers={}",
-            path.string(),
-            metadata->resource_info.num_samplers,
-            metadata->resource_info.num_storage_textures,
-            metadata->resource_info.num_storage_buffers,
-            metadata->resource_info.num_uniform_buffers);
-
-        // Create GPU shader from SPIR-V
-        SDL_ShaderCross_SPIRV_Info spirvInfo{};
-        spirvInfo.bytecode = static_cast<const Uint8*>(spirvCode);
-        spirvInfo.bytecode_size = spirvSize;
-        spirvInfo.entrypoint = entrypoint;
-        spirvInfo.shader_stage = SDL_SHADERCROSS_SHADERSTAGE_FRAGMENT;
-        spirvInfo.props = 0;
-
-        SDL_GPUShader* shader = SDL_ShaderCross_CompileGraphicsShaderFromSPIRV(
-            m_device, &spirvInfo, &metadata->resource_info, 0);
+        initialize_shadercross();
+    }
 
-        SDL_free(metadata);
-        SDL_free(spirvCode);
+    void Shader::load_shader(const std::filesystem::path& path, const char* entrypoint, SDL_GPUShaderStage stage,
+                             const std::vector<ShaderDefine>& defines, GPUShaderPtr& target) {
+        ShaderSourceDesc desc;
+        desc.path = path;
+        desc.entrypoint = entrypoint;
+        desc.stage = stage;
+        desc.defines = defines;
+        target = create_gpu_shader(m_device, compile_shader(desc, m_cache));
+    }
 
-        if (!shader) {
-            throw ShaderException(std::string("Failed to create fragment shader: ") + SDL_GetError());
-        }
-        m_fragmentShader.reset(shader);
+    void Shader::load_vertex_shader(const std::filesystem::path& path, const char* entrypoint, const std::vector<ShaderDefine>& defines) {
+        load_shader(path, entrypoint, SDL_GPU_SHADERSTAGE_VERTEX, defines, m_vertexShader);
+    }
+
+    void Shader::load_fragment_shader(const std::filesystem::path& path, const char* entrypoint, const std::vector<ShaderDefine>& defines) {
+        load_shader(path, entrypoint, SDL_GPU_SHADERSTAGE_FRAGMENT, defines, m_fragmentShader);
     }
 
     void Shader::bind(SDL_GPUCommandBuffer* commandBuffer, SDL_GPURenderPass* renderPass, SDL_GPUGraphicsPipeline* pipeline) {
         SDL_BindGPUGraphicsPipeline(renderPass, pipeline);
+        GpuStats::get().add_pipeline_bind();
     }
 
     void Shader::set_vertex_uniform_raw(SDL_GPUCommandBuffer* commandBuffer, uint32_t slot, const void* data, uint32_t size) {
         SDL_PushGPUVertexUniformData(commandBuffer, slot, data, size);
+        GpuStats::get().add_uniform_push(size);
     }
 
     void Shader::set_fragment_uniform_raw(SDL_GPUCommandBuffer* commandBuffer, uint32_t slot, const void* data, uint32_t size) {
-        spdlog::info("Shader::set_fragment_uniform_raw: pushing {} bytes to slot {}", size, slot);
         SDL_PushGPUFragmentUniformData(commandBuffer, slot, data, size);
+        GpuStats::get().add_uniform_push(size);
     }
 
 } // namespace minecart::graphics
@@ -0,0 +1,270 @@
+#include "minecart/shader_cache.hpp"
+#include "minecart/hash.hpp"
+
+#include <SDL3_shadercross/SDL_shadercross.h>
+#include <spdlog/spdlog.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+
+namespace minecart::graphics {
+
+    namespace {
+
+        constexpr uint32_t ENTRY_MAGIC = 0x4353434Du;   // "MCSC"
+        constexpr uint32_t SPIRV_MAGIC = 0x07230203u;
+        constexpr uint32_t MAX_INCLUDE_DEPTH = 32;
+
+        template<typename T>
+        uint64_t fnv1a_value(uint64_t hash, const T& value) {
+            return fnv1a(&value, sizeof(T), hash);
+        }
+
+        // Length first, so "ab"+"c" and "a"+"bc" hash differently
+        uint64_t fnv1a_string(uint64_t hash, const std::string& value) {
+            hash = fnv1a_value(hash, static_cast<uint64_t>(value.size()));
+            return fnv1a(value, hash);
+        }
+
+        bool read_file(const std::filesystem::path& path, std::string& out) {
+            std::ifstream file(path, std::ios::binary);
+            if (!file.is_open()) {
+                return false;
+            }
+            out.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            return true;
+        }
+
+        // Names of the #include directives in source, in order
+        std::vector<std::string> find_includes(const std::string& source) {
+            std::vector<std::string> includes;
+            std::istringstream stream(source);
+            std::string line;
+            while (std::getline(stream, line)) {
+                size_t pos = line.find_first_not_of(" \t");
+                if (pos == std::string::npos || line[pos] != '#') {
+                    continue;
+                }
+                pos = line.find_first_not_of(" \t", pos + 1);
+                if (pos == std::string::npos || line.compare(pos, 7, "include") != 0) {
+                    continue;
+                }
+                pos = line.find_first_of("\"<", pos + 7);
+                if (pos == std::string::npos) {
+                    continue;
+                }
+                const char close = line[pos] == '"' ? '"' : '>';
+                size_t end = line.find(close, pos + 1);
+                if (end != std::string::npos) {
+                    includes.push_back(line.substr(pos + 1, end - pos - 1));
+                }
+            }
+            return includes;
+        }
+
+        // Hash every file source includes, directly or not, the way the compiler
+        // resolves them: next to the including file, then in the include directory
+        uint64_t hash_includes(uint64_t hash, const std::string& source, const std::filesystem::path& directory,
+                               const std::filesystem::path& includeDir, std::unordered_set<std::string>& visited, uint32_t depth) {
+            if (depth >= MAX_INCLUDE_DEPTH) {
+                return hash;
+            }
+
+            for (const std::string& name : find_includes(source)) {
+                hash = fnv1a_string(hash, name);
+
+                std::string contents;
+                std::filesystem::path resolved = (directory / name).lexically_normal();
+                if (!read_file(resolved, contents)) {
+                    resolved = (includeDir / name).lexically_normal();
+                    if (!read_file(resolved, contents)) {
+                        hash = fnv1a_string(hash, "<missing>");
+                        continue;
+                    }
+                }
+
+                hash = fnv1a_string(hash, contents);
+                if (visited.insert(resolved.string()).second) {
+                    hash = hash_includes(hash, contents, resolved.parent_path(), includeDir, visited, depth + 1);
+                }
+            }
+            return hash;
+        }
+
+        template<typename T>
+        void write_value(std::ostream& out, const T& value) {
+            out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+
+        template<typename T>
+        bool read_value(std::istream& in, T& value) {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(&value), sizeof(T)));
+        }
+
+    } // namespace
+
+    ShaderCache::ShaderCache(std::filesystem::path directory)
+        : m_directory(std::move(directory))
+    {
+        std::error_code error;
+        std::filesystem::create_directories(m_directory, error);
+        if (error) {
+            throw ShaderCacheException("Failed to create cache directory " + m_directory.string() + ": " + error.message());
+        }
+    }
+
+    uint64_t ShaderCache::compute_key(const ShaderSourceDesc& desc, const std::string& source) {
+        uint64_t hash = fnv1a_value(FNV1A_OFFSET, FORMAT_VERSION);
+        hash = fnv1a_value(hash, static_cast<uint32_t>(SDL_SHADERCROSS_MAJOR_VERSION));
+        hash = fnv1a_value(hash, static_cast<uint32_t>(SDL_SHADERCROSS_MINOR_VERSION));
+        hash = fnv1a_value(hash, static_cast<uint32_t>(SDL_SHADERCROSS_MICRO_VERSION));
+        hash = fnv1a_value(hash, static_cast<uint32_t>(desc.stage));
+        hash = fnv1a_string(hash, desc.entrypoint);
+        hash = fnv1a_value(hash, static_cast<uint64_t>(desc.defines.size()));
+        for (const ShaderDefine& define : desc.defines) {
+            hash = fnv1a_string(hash, define.name);
+            hash = fnv1a_string(hash, define.value);
+        }
+        hash = fnv1a_string(hash, source);
+
+        const std::filesystem::path directory = desc.path.parent_path();
+        std::unordered_set<std::string> visited;
+        return hash_includes(hash, source, directory, directory, visited, 0);
+    }
+
+    std::filesystem::path ShaderCache::entry_path(uint64_t key) const {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.spv", static_cast<unsigned long long>(key));
+        return m_directory / name;
+    }
+
+    bool ShaderCache::load(uint64_t key, const ShaderSourceDesc& desc, CompiledShader& out) {
+        const std::filesystem::path path = entry_path(key);
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            return false;
+        }
+
+        // Header: magic, version, key, stage, resource counts, SPIR-V size and hash
+        uint32_t magic = 0, version = 0, stage = 0;
+        uint64_t storedKey = 0, spirvSize = 0, spirvHash = 0;
+        ShaderResourceInfo resources;
+        bool valid = read_value(file, magic) && read_value(file, version) && read_value(file, storedKey)
+            && read_value(file, stage) && read_value(file, resources.numSamplers)
+            && read_value(file, resources.numStorageTextures) && read_value(file, resources.numStorageBuffers)
+            && read_value(file, resources.numUniformBuffers) && read_value(file, spirvSize) && read_value(file, spirvHash);
+        valid = valid && magic == ENTRY_MAGIC && version == FORMAT_VERSION && storedKey == key
+            && stage == static_cast<uint32_t>(desc.stage) && spirvSize >= sizeof(uint32_t) && spirvSize % sizeof(uint32_t) == 0;
+
+        std::vector<uint8_t> spirv;
+        if (valid) {
+            spirv.resize(static_cast<size_t>(spirvSize));
+            valid = static_cast<bool>(file.read(reinterpret_cast<char*>(spirv.data()), static_cast<std::streamsize>(spirvSize)))
+                && file.peek() == std::char_traits<char>::eof();
+        }
+        if (valid) {
+            uint32_t spirvMagic = 0;
+            std::memcpy(&spirvMagic, spirv.data(), sizeof(spirvMagic));
+            valid = spirvMagic == SPIRV_MAGIC && fnv1a(spirv.data(), spirv.size()) == spirvHash;
+        }
+
+        if (!valid) {
+            spdlog::warn("Discarding corrupt shader cache entry {}", path.string());
+            file.close();
+            std::error_code error;
+            std::filesystem::remove(path, error);
+            m_rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        out.spirv = std::move(spirv);
+        out.resources = resources;
+        out.entrypoint = desc.entrypoint;
+        out.stage = desc.stage;
+        out.fromCache = true;
+        return true;
+    }
+
+    void ShaderCache::store(uint64_t key, const CompiledShader& shader) {
+        const std::filesystem::path path = entry_path(key);
+
+        // Write next to the entry and rename, so readers never see a partial file
+        std::filesystem::path temporary = path;
+        temporary += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()));
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+            if (!file.is_open()) {
+                spdlog::warn("Failed to write shader cache entry {}", path.string());
+                return;
+            }
+
+            write_value(file, ENTRY_MAGIC);
+            write_value(file, FORMAT_VERSION);
+            write_value(file, key);
+            write_value(file, static_cast<uint32_t>(shader.stage));
+            write_value(file, shader.resources.numSamplers);
+            write_value(file, shader.resources.numStorageTextures);
+            write_value(file, shader.resources.numStorageBuffers);
+            write_value(file, shader.resources.numUniformBuffers);
+            write_value(file, static_cast<uint64_t>(shader.spirv.size()));
+            write_value(file, fnv1a(shader.spirv.data(), shader.spirv.size()));
+            file.write(reinterpret_cast<const char*>(shader.spirv.data()), static_cast<std::streamsize>(shader.spirv.size()));
+            if (!file.good()) {
+                file.close();
+                std::error_code error;
+                std::filesystem::remove(temporary, error);
+                spdlog::warn("Failed to write shader cache entry {}", path.string());
+                return;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        if (error) {
+            std::filesystem::remove(temporary, error);
+            spdlog::warn("Failed to write shader cache entry {}", path.string());
+        }
+    }
+
+    void ShaderCache::clear() {
+        std::error_code error;
+        for (const auto& entry : std::filesystem::directory_iterator(m_directory, error)) {
+            if (entry.path().extension() == ".spv") {
+                std::filesystem::remove(entry.path(), error);
+            }
+        }
+    }
+
+    void ShaderCache::record(const CompiledShader& shader) noexcept {
+        if (shader.fromCache) {
+            m_hits.fetch_add(1, std::memory_order_relaxed);
+            m_hitTimeNS.fetch_add(shader.timeNS, std::memory_order_relaxed);
+        } else {
+            m_misses.fetch_add(1, std::memory_order_relaxed);
+            m_missTimeNS.fetch_add(shader.timeNS, std::memory_order_relaxed);
+        }
+    }
+
+    ShaderCacheStats ShaderCache::get_stats() const noexcept {
+        ShaderCacheStats stats;
+        stats.hits = m_hits.load(std::memory_order_relaxed);
+        stats.misses = m_misses.load(std::memory_order_relaxed);
+        stats.rejected = m_rejected.load(std::memory_order_relaxed);
+        stats.hitTimeNS = m_hitTimeNS.load(std::memory_order_relaxed);
+        stats.missTimeNS = m_missTimeNS.load(std::memory_order_relaxed);
+        return stats;
+    }
+
+    void ShaderCache::log_stats() const {
+        ShaderCacheStats stats = get_stats();
+        spdlog::info("Shader cache: {} hits loaded in {:.1f} ms, {} misses compiled in {:.1f} ms ({} corrupt entries)",
+            stats.hits, stats.hitTimeNS * 1e-6, stats.misses, stats.missTimeNS * 1e-6, stats.rejected);
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,140 @@
+#include "minecart/shader_library.hpp"
+#include "minecart/profiler.hpp"
+
+#include <spdlog/spdlog.h>
+
+namespace minecart::graphics {
+
+    ShaderLibrary::ShaderLibrary(SDL_GPUDevice* device, JobSystem& jobSystem, ShaderCache* cache)
+        : m_device(device)
+        , m_jobSystem(jobSystem)
+        , m_cache(cache)
+        , m_vertexPlaceholder(nullptr, SDLGPUShaderDeleter{device})
+        , m_fragmentPlaceholder(nullptr, SDLGPUShaderDeleter{device})
+    {
+        if (!device) {
+            throw ShaderLibraryException("Device cannot be null");
+        }
+        initialize_shadercross();
+    }
+
+    ShaderLibrary::~ShaderLibrary() {
+        m_jobSystem.wait(m_counter);
+    }
+
+    ShaderHandle ShaderLibrary::add(const std::string& name, const ShaderSourceDesc& source) {
+        Entry* entry = nullptr;
+        ShaderHandle handle = 0;
+        {
+            std::lock_guard lock(m_mutex);
+            for (const std::unique_ptr<Entry>& existing : m_entries) {
+                if (existing->name == name) {
+                    throw ShaderLibraryException("Shader already added: " + name);
+                }
+            }
+            handle = static_cast<ShaderHandle>(m_entries.size());
+            m_entries.push_back(std::make_unique<Entry>());
+            entry = m_entries.back().get();
+            entry->name = name;
+            entry->source = source;
+        }
+
+        m_jobSystem.submit([this, entry] { compile(*entry); }, &m_counter);
+        return handle;
+    }
+
+    std::vector<ShaderHandle> ShaderLibrary::add_manifest(const std::vector<ShaderManifestEntry>& manifest) {
+        std::vector<ShaderHandle> handles;
+        handles.reserve(manifest.size());
+        for (const ShaderManifestEntry& entry : manifest) {
+            handles.push_back(add(entry.name, entry.source));
+        }
+        return handles;
+    }
+
+    void ShaderLibrary::set_placeholder(const ShaderSourceDesc& source) {
+        GPUShaderPtr shader = create_gpu_shader(m_device, compile_shader(source, m_cache));
+        std::lock_guard lock(m_mutex);
+        (source.stage == SDL_GPU_SHADERSTAGE_VERTEX ? m_vertexPlaceholder : m_fragmentPlaceholder) = std::move(shader);
+    }
+
+    void ShaderLibrary::compile(Entry& entry) {
+        MINECART_PROFILE_SCOPE("ShaderLibrary::compile");
+        try {
+            entry.compiled = compile_shader(entry.source, m_cache);
+        }
+        catch (const std::exception& e) {
+            fail(entry, e.what());
+            return;
+        }
+
+        // GPU objects are created on the device (main) thread
+        m_jobSystem.submit_main([this, &entry] { create(entry); }, &m_counter);
+    }
+
+    void ShaderLibrary::create(Entry& entry) {
+        MINECART_PROFILE_SCOPE("ShaderLibrary::create");
+        try {
+            entry.shader = create_gpu_shader(m_device, entry.compiled);
+        }
+        catch (const std::exception& e) {
+            fail(entry, e.what());
+            return;
+        }
+        entry.compiled = CompiledShader{};
+        entry.state.store(ShaderState::Ready, std::memory_order_release);
+    }
+
+    void ShaderLibrary::fail(Entry& entry, const std::string& message) {
+        spdlog::error("Failed to build shader '{}': {}", entry.name, message);
+        entry.error = message;
+        entry.state.store(ShaderState::Failed, std::memory_order_release);
+    }
+
+    SDL_GPUShader* ShaderLibrary::get(ShaderHandle handle) const {
+        const Entry& entry = get_entry(handle);
+        if (entry.state.load(std::memory_order_acquire) == ShaderState::Ready) {
+            return entry.shader.get();
+        }
+        std::lock_guard lock(m_mutex);
+        return entry.source.stage == SDL_GPU_SHADERSTAGE_VERTEX ? m_vertexPlaceholder.get() : m_fragmentPlaceholder.get();
+    }
+
+    void ShaderLibrary::wait_all() {
+        m_jobSystem.wait(m_counter);
+    }
+
+    ShaderLibrary::Entry& ShaderLibrary::get_entry(ShaderHandle handle) const {
+        std::lock_guard lock(m_mutex);
+        if (handle >= m_entries.size()) {
+            throw ShaderLibraryException("Invalid shader handle " + std::to_string(handle));
+        }
+        return *m_entries[handle];
+    }
+
+    ShaderHandle ShaderLibrary::find(const std::string& name) const {
+        std::lock_guard lock(m_mutex);
+        for (size_t i = 0; i < m_entries.size(); ++i) {
+            if (m_entries[i]->name == name) {
+                return static_cast<ShaderHandle>(i);
+            }
+        }
+        throw ShaderLibraryException("Unknown shader: " + name);
+    }
+
+    ShaderState ShaderLibrary::get_state(ShaderHandle handle) const {
+        return get_entry(handle).state.load(std::memory_order_acquire);
+    }
+
+    const std::string& ShaderLibrary::get_error(ShaderHandle handle) const {
+        const Entry& entry = get_entry(handle);
+        static const std::string none;
+        return entry.state.load(std::memory_order_acquire) == ShaderState::Failed ? entry.error : none;
+    }
+
+    size_t ShaderLibrary::get_shader_count() const {
+        std::lock_guard lock(m_mutex);
+        return m_entries.size();
+    }
+
+} // namespace minecart::graphics
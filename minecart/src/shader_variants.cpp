@@ -0,0 +1,113 @@
+#include "minecart/shader_variants.hpp"
+#include "minecart/hash.hpp"
+
+#include <cstdio>
+
+namespace minecart::graphics {
+
+    ShaderVariants::ShaderVariants(SDL_GPUDevice* device, ShaderSourceDesc source, std::vector<std::string> features,
+                                   ShaderCache* cache, ShaderLibrary* library)
+        : m_device(device)
+        , m_cache(cache)
+        , m_library(library)
+        , m_source(std::move(source))
+        , m_features(std::move(features))
+    {
+        if (!device) {
+            throw ShaderVariantException("Device cannot be null");
+        }
+        if (m_features.size() > MAX_FEATURES) {
+            throw ShaderVariantException("At most " + std::to_string(MAX_FEATURES) + " feature keys are supported");
+        }
+        for (size_t i = 0; i < m_features.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (m_features[i] == m_features[j]) {
+                    throw ShaderVariantException("Duplicate feature key: " + m_features[i]);
+                }
+            }
+        }
+        m_validMask = m_features.size() == MAX_FEATURES ? ~0u : (1u << m_features.size()) - 1;
+
+        // Library names must be unique, so tell apart sets on the same file and entry
+        // point by stage, base defines and feature keys (a mask means different
+        // defines in sets with different keys)
+        uint64_t defineHash = FNV1A_OFFSET;
+        auto hash_string = [&defineHash](const std::string& value) {
+            defineHash = fnv1a(value + '\0', defineHash);     // Terminator separates the strings
+        };
+        for (const ShaderDefine& define : m_source.defines) {
+            hash_string(define.name);
+            hash_string(define.value);
+        }
+        for (const std::string& feature : m_features) {
+            hash_string(feature);
+        }
+        char suffix[32];
+        std::snprintf(suffix, sizeof(suffix), "#%016llx", static_cast<unsigned long long>(defineHash));
+        m_libraryName = m_source.path.string() + ":" + m_source.entrypoint
+            + (m_source.stage == SDL_GPU_SHADERSTAGE_VERTEX ? ":vertex" : ":fragment") + suffix;
+        if (!library) {
+            initialize_shadercross();
+        }
+    }
+
+    ShaderFeatureMask ShaderVariants::bit_of(const std::string& feature) const {
+        for (size_t i = 0; i < m_features.size(); ++i) {
+            if (m_features[i] == feature) {
+                return 1u << i;
+            }
+        }
+        throw ShaderVariantException("Unknown feature key: " + feature);
+    }
+
+    ShaderFeatureMask ShaderVariants::mask_of(const std::vector<std::string>& features) const {
+        ShaderFeatureMask mask = 0;
+        for (const std::string& feature : features) {
+            mask |= bit_of(feature);
+        }
+        return mask;
+    }
+
+    std::vector<ShaderDefine> ShaderVariants::defines_for(ShaderFeatureMask mask) const {
+        std::vector<ShaderDefine> defines = m_source.defines;
+        for (size_t i = 0; i < m_features.size(); ++i) {
+            if (mask & (1u << i)) {
+                defines.push_back(ShaderDefine{m_features[i], "1"});
+            }
+        }
+        return defines;
+    }
+
+    ShaderVariants::Variant& ShaderVariants::request(ShaderFeatureMask mask) {
+        auto it = m_variants.find(mask);
+        if (it != m_variants.end()) {
+            return it->second;
+        }
+        if (mask & ~m_validMask) {
+            throw ShaderVariantException("Mask has bits without a feature key");
+        }
+
+        ShaderSourceDesc desc = m_source;
+        desc.defines = defines_for(mask);
+
+        Variant variant;
+        if (m_library) {
+            char suffix[16];
+            std::snprintf(suffix, sizeof(suffix), "#%08x", mask);
+            variant.handle = m_library->add(m_libraryName + suffix, desc);
+        } else {
+            variant.shader = create_gpu_shader(m_device, compile_shader(desc, m_cache));
+        }
+        return m_variants.emplace(mask, std::move(variant)).first->second;
+    }
+
+    SDL_GPUShader* ShaderVariants::get(ShaderFeatureMask mask) {
+        Variant& variant = request(mask);
+        return m_library ? m_library->get(variant.handle) : variant.shader.get();
+    }
+
+    void ShaderVariants::prepare(ShaderFeatureMask mask) {
+        request(mask);
+    }
+
+} // namespace minecart::graphics
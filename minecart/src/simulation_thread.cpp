@@ -0,0 +1,83 @@
+#include "minecart/simulation_thread.hpp"
+#include "minecart/profiler.hpp"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+namespace minecart {
+
+    void SimulationThread::start(double tickRate, TickFunction tick) {
+        if (!(tickRate > 0.0)) {
+            throw SimulationException("Tick rate must be positive");
+        }
+        stop();
+
+        m_tickRate = tickRate;
+        m_tick = std::move(tick);
+        m_stopping.store(false, std::memory_order_relaxed);
+        m_quit.store(false, std::memory_order_relaxed);
+        m_failed.store(false, std::memory_order_relaxed);
+        m_ticks.store(0, std::memory_order_relaxed);
+        m_droppedTicks.store(0, std::memory_order_relaxed);
+        m_thread = std::thread([this] { run(); });
+    }
+
+    void SimulationThread::stop() {
+        if (!m_thread.joinable()) {
+            return;
+        }
+        m_stopping.store(true, std::memory_order_release);
+        m_thread.join();
+    }
+
+    float SimulationThread::get_interpolation_alpha() const noexcept {
+        Uint64 lastTick = m_lastTickNS.load(std::memory_order_relaxed);
+        Uint64 now = SDL_GetTicksNS();
+        if (lastTick == 0 || now <= lastTick) {
+            return 0.0f;
+        }
+        double alpha = static_cast<double>(now - lastTick) * 1e-9 * m_tickRate;
+        return static_cast<float>(alpha < 1.0 ? alpha : 1.0);
+    }
+
+    void SimulationThread::run() {
+        MINECART_PROFILE_THREAD("Simulation");
+        const double tickSeconds = 1.0 / m_tickRate;
+        const auto tickNS = static_cast<Uint64>(tickSeconds * 1e9);
+        Uint64 nextTick = SDL_GetTicksNS();
+
+        while (!m_stopping.load(std::memory_order_acquire)) {
+            Uint64 now = SDL_GetTicksNS();
+            if (now < nextTick) {
+                SDL_DelayPrecise(nextTick - now);
+                continue;
+            }
+
+            // Too far behind to catch up without a burst of ticks: resynchronise
+            if (now - nextTick > tickNS * MAX_CATCH_UP_TICKS) {
+                m_droppedTicks.fetch_add((now - nextTick) / tickNS, std::memory_order_relaxed);
+                nextTick = now;
+            }
+
+            m_lastTickNS.store(nextTick, std::memory_order_relaxed);
+
+            bool keepRunning = false;
+            try {
+                MINECART_PROFILE_SCOPE("Game::on_tick");
+                keepRunning = m_tick(tickSeconds);
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Simulation Error: {}", e.what());
+                m_failed.store(true, std::memory_order_relaxed);   // Published by the m_quit store
+            }
+            m_ticks.fetch_add(1, std::memory_order_relaxed);
+
+            if (!keepRunning) {
+                m_quit.store(true, std::memory_order_release);
+                return;
+            }
+            nextTick += tickNS;
+        }
+    }
+
+} // namespace minecart
@@ -0,0 +1,137 @@
+#include "minecart/staging_ring.hpp"
+#include "minecart/gpu_stats.hpp"
+#include "minecart/upload_queue.hpp"
+
+#include <cstring>
+#include <string>
+
+namespace minecart::graphics {
+
+    static SDL_GPUTransferBuffer* create_upload_transfer_buffer(SDL_GPUDevice* device, uint32_t size) {
+        SDL_GPUTransferBufferCreateInfo transferInfo{};
+        transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+        transferInfo.size = size;
+
+        SDL_GPUTransferBuffer* transferBuffer = SDL_CreateGPUTransferBuffer(device, &transferInfo);
+        if (!transferBuffer) {
+            throw UploadException(std::string("Failed to create transfer buffer: ") + SDL_GetError());
+        }
+        GpuStats::get().add_transfer_buffer();
+        return transferBuffer;
+    }
+
+    StagingRing::StagingRing(SDL_GPUDevice* device, uint32_t blockSize, uint32_t blockCount)
+        : m_device(device)
+        , m_blockSize(blockSize)
+    {
+        if (!device) {
+            throw UploadException("Device cannot be null");
+        }
+        if (blockSize == 0 || blockCount == 0) {
+            throw UploadException("Staging ring needs at least one non-empty block");
+        }
+
+        m_blocks.reserve(blockCount);
+        try {
+            for (uint32_t i = 0; i < blockCount; ++i) {
+                m_blocks.push_back(create_upload_transfer_buffer(device, blockSize));
+            }
+        }
+        catch (...) {
+            for (SDL_GPUTransferBuffer* block : m_blocks) {
+                SDL_ReleaseGPUTransferBuffer(m_device, block);
+            }
+            throw;
+        }
+    }
+
+    StagingRing::~StagingRing() {
+        release_transient();
+        for (SDL_GPUTransferBuffer* block : m_blocks) {
+            SDL_ReleaseGPUTransferBuffer(m_device, block);
+        }
+    }
+
+    void StagingRing::begin_frame() {
+        release_transient();
+
+        if (m_head > 0) {
+            advance_block();
+        }
+        m_blocksUsedThisFrame = 1;
+    }
+
+    void StagingRing::advance_block() {
+        m_currentBlock = (m_currentBlock + 1) % static_cast<uint32_t>(m_blocks.size());
+        m_head = 0;
+        m_cycleOnNextMap = true;
+    }
+
+    StagingAllocation StagingRing::write(std::span<const std::byte> data, uint32_t alignment) {
+        if (data.empty()) {
+            return {};
+        }
+        if (data.size() > m_blockSize) {
+            return write_transient(data);
+        }
+
+        uint32_t size = static_cast<uint32_t>(data.size());
+        uint32_t offset = alignment > 1 ? (m_head + alignment - 1) / alignment * alignment : m_head;
+
+        if (offset > m_blockSize || size > m_blockSize - offset) {
+            advance_block();
+            offset = 0;
+            m_stats.wraps++;
+
+            // Every block already holds data for this frame, so the driver has to cycle
+            if (++m_blocksUsedThisFrame > m_blocks.size()) {
+                m_stats.stalls++;
+            }
+        }
+
+        SDL_GPUTransferBuffer* block = m_blocks[m_currentBlock];
+
+        // Only the first map of a block cycles it; later regions are disjoint
+        auto* mappedData = static_cast<std::byte*>(SDL_MapGPUTransferBuffer(m_device, block, m_cycleOnNextMap));
+        if (!mappedData) {
+            throw UploadException(std::string("Failed to map staging block: ") + SDL_GetError());
+        }
+        std::memcpy(mappedData + offset, data.data(), size);
+        SDL_UnmapGPUTransferBuffer(m_device, block);
+        m_cycleOnNextMap = false;
+
+        m_head = offset + size;
+        m_stats.allocations++;
+        m_stats.bytesAllocated += size;
+
+        return StagingAllocation{block, offset, size};
+    }
+
+    StagingAllocation StagingRing::write_transient(std::span<const std::byte> data) {
+        uint32_t size = static_cast<uint32_t>(data.size());
+        SDL_GPUTransferBuffer* transferBuffer = create_upload_transfer_buffer(m_device, size);
+
+        void* mappedData = SDL_MapGPUTransferBuffer(m_device, transferBuffer, false);
+        if (!mappedData) {
+            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
+            throw UploadException(std::string("Failed to map transfer buffer: ") + SDL_GetError());
+        }
+        std::memcpy(mappedData, data.data(), size);
+        SDL_UnmapGPUTransferBuffer(m_device, transferBuffer);
+
+        // Kept alive until the copy referencing it has been recorded
+        m_transient.push_back(transferBuffer);
+        m_stats.oversizedFallbacks++;
+        m_stats.bytesAllocated += size;
+
+        return StagingAllocation{transferBuffer, 0, size};
+    }
+
+    void StagingRing::release_transient() noexcept {
+        for (SDL_GPUTransferBuffer* transferBuffer : m_transient) {
+            SDL_ReleaseGPUTransferBuffer(m_device, transferBuffer);
+        }
+        m_transient.clear();
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,169 @@
+#include "minecart/upload_queue.hpp"
+#include "minecart/gpu_stats.hpp"
+#include "minecart/profiler.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace minecart::graphics {
+
+    // Staging regions are packed at this alignment inside the shared transfer buffer
+    static constexpr size_t STAGING_ALIGNMENT = 4;
+
+    UploadQueue::UploadQueue(SDL_GPUDevice* device, StagingRing* stagingRing)
+        : m_device(device)
+        , m_stagingRing(stagingRing)
+    {
+        if (!device) {
+            throw UploadException("Device cannot be null");
+        }
+    }
+
+    uint64_t UploadQueue::enqueue(SDL_GPUBuffer* buffer, uint32_t offset, std::span<const std::byte> data, bool cycle) {
+        if (!buffer) {
+            throw UploadException("Destination buffer cannot be null");
+        }
+        if (data.empty()) {
+            return m_currentBatch;
+        }
+
+        size_t stagingOffset = (m_staging.size() + STAGING_ALIGNMENT - 1) & ~(STAGING_ALIGNMENT - 1);
+        m_staging.resize(stagingOffset + data.size());
+        std::memcpy(m_staging.data() + stagingOffset, data.data(), data.size());
+
+        m_pending.push_back(PendingUpload{
+            buffer,
+            static_cast<uint32_t>(stagingOffset),
+            offset,
+            static_cast<uint32_t>(data.size()),
+            cycle
+        });
+        return m_currentBatch;
+    }
+
+    void UploadQueue::discard(SDL_GPUBuffer* buffer) noexcept {
+        // The staging bytes stay behind until the next batch; only the copies are dropped
+        std::erase_if(m_pending, [buffer](const PendingUpload& upload) {
+            return upload.buffer == buffer;
+        });
+    }
+
+    void UploadQueue::discard(SDL_GPUBuffer* buffer, uint32_t offset, uint32_t size) noexcept {
+        const uint64_t end = static_cast<uint64_t>(offset) + size;
+        std::erase_if(m_pending, [buffer, offset, end](const PendingUpload& upload) {
+            return upload.buffer == buffer && upload.offset >= offset
+                && static_cast<uint64_t>(upload.offset) + upload.size <= end;
+        });
+    }
+
+    void UploadQueue::record(SDL_GPUCommandBuffer* commandBuffer) {
+        if (!commandBuffer) {
+            throw UploadException("Command buffer cannot be null");
+        }
+        record_batch(commandBuffer, false);
+    }
+
+    void UploadQueue::flush() {
+        if (m_pending.empty()) {
+            return;
+        }
+
+        SDL_GPUCommandBuffer* commandBuffer = SDL_AcquireGPUCommandBuffer(m_device);
+        if (!commandBuffer) {
+            throw UploadException(std::string("Failed to acquire command buffer: ") + SDL_GetError());
+        }
+
+        try {
+            record_batch(commandBuffer, true);
+        }
+        catch (...) {
+            SDL_SubmitGPUCommandBuffer(commandBuffer);
+            throw;
+        }
+
+        if (!SDL_SubmitGPUCommandBuffer(commandBuffer)) {
+            throw UploadException(std::string("Failed to submit upload command buffer: ") + SDL_GetError());
+        }
+    }
+
+    void UploadQueue::record_batch(SDL_GPUCommandBuffer* commandBuffer, bool dedicatedSubmit) {
+        MINECART_PROFILE_SCOPE("UploadQueue::record");
+        if (m_pending.empty()) {
+            m_staging.clear();
+            m_recordedBatch = m_currentBatch++;
+            return;
+        }
+
+        // One staging allocation holds every region of the batch
+        StagingAllocation staging{};
+        SDL_GPUTransferBuffer* ownedTransferBuffer = nullptr;
+
+        if (m_stagingRing) {
+            staging = m_stagingRing->write(m_staging);
+        } else {
+            SDL_GPUTransferBufferCreateInfo transferInfo{};
+            transferInfo.usage = SDL_GPU_TRANSFERBUFFERUSAGE_UPLOAD;
+            transferInfo.size = static_cast<Uint32>(m_staging.size());
+
+            ownedTransferBuffer = SDL_CreateGPUTransferBuffer(m_device, &transferInfo);
+            if (!ownedTransferBuffer) {
+                throw UploadException(std::string("Failed to create transfer buffer: ") + SDL_GetError());
+            }
+            GpuStats::get().add_transfer_buffer();
+
+            void* mappedData = SDL_MapGPUTransferBuffer(m_device, ownedTransferBuffer, false);
+            if (!mappedData) {
+                SDL_ReleaseGPUTransferBuffer(m_device, ownedTransferBuffer);
+                throw UploadException(std::string("Failed to map transfer buffer: ") + SDL_GetError());
+            }
+            std::memcpy(mappedData, m_staging.data(), m_staging.size());
+            SDL_UnmapGPUTransferBuffer(m_device, ownedTransferBuffer);
+
+            staging = StagingAllocation{ownedTransferBuffer, 0, static_cast<uint32_t>(m_staging.size())};
+        }
+
+        SDL_GPUCopyPass* copyPass = SDL_BeginGPUCopyPass(commandBuffer);
+        if (!copyPass) {
+            if (ownedTransferBuffer) {
+                SDL_ReleaseGPUTransferBuffer(m_device, ownedTransferBuffer);
+            }
+            throw UploadException(std::string("Failed to begin copy pass: ") + SDL_GetError());
+        }
+
+        uint64_t bytes = 0;
+        for (const PendingUpload& upload : m_pending) {
+            SDL_GPUTransferBufferLocation srcLocation{};
+            srcLocation.transfer_buffer = staging.transferBuffer;
+            srcLocation.offset = staging.offset + upload.stagingOffset;
+
+            SDL_GPUBufferRegion dstRegion{};
+            dstRegion.buffer = upload.buffer;
+            dstRegion.offset = upload.offset;
+            dstRegion.size = upload.size;
+
+            SDL_UploadToGPUBuffer(copyPass, &srcLocation, &dstRegion, upload.cycle);
+            bytes += upload.size;
+        }
+        GpuStats::get().add_upload(bytes);
+
+        SDL_EndGPUCopyPass(copyPass);
+
+        // Released once the command buffer has finished executing
+        if (ownedTransferBuffer) {
+            SDL_ReleaseGPUTransferBuffer(m_device, ownedTransferBuffer);
+        }
+
+        uint32_t uploads = static_cast<uint32_t>(m_pending.size());
+        m_stats.flushes++;
+        m_stats.uploads += uploads;
+        m_stats.submitsSaved += dedicatedSubmit ? uploads - 1 : uploads;
+        m_stats.bytesTotal += bytes;
+        m_stats.lastFlushBytes = bytes;
+        m_stats.lastFlushUploads = uploads;
+
+        m_pending.clear();
+        m_staging.clear();
+        m_recordedBatch = m_currentBatch++;
+    }
+
+} // namespace minecart::graphics
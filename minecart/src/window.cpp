@@ -1,7 +1,11 @@
 #include "minecart/window.hpp"
 #include "minecart/common.hpp"
+#include "minecart/gpu_stats.hpp"
+#include "minecart/profiler.hpp"
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
+
 namespace minecart::graphics {
 
     Window::Window(Game* game)
@@ -99,9 +103,35 @@ namespace minecart::graphics {
             throw ImGuiException("Failed to initialize ImGui SDL GPU3 backend");
         }
 
+        // Uploads queued by the game are recorded at the start of each frame,
+        // staged through a ring of persistent transfer buffers. Models created
+        // with the shared arena are packed into a few large buffers.
+        try {
+            m_stagingRing = std::make_unique<StagingRing>(device.get());
+            m_uploadQueue = std::make_unique<UploadQueue>(device.get(), m_stagingRing.get());
+            m_bufferArena = std::make_unique<GpuBufferArena>(
+                device.get(),
+                SDL_GPU_BUFFERUSAGE_VERTEX | SDL_GPU_BUFFERUSAGE_INDEX,
+                GpuBufferArena::DEFAULT_PAGE_SIZE,
+                m_uploadQueue.get());
+        }
+        catch (const std::runtime_error& e) {
+            m_uploadQueue.reset();
+            m_stagingRing.reset();
+            ImGui_ImplSDLGPU3_Shutdown();
+            ImGui_ImplSDL3_Shutdown();
+            ImGui::DestroyContext();
+            device.reset();
+            window.reset();
+            throw WindowException(e.what());
+        }
+
         imguiInitialized = true;
         initialized = true;
-        m_lastFrameTime = SDL_GetTicks();
+        apply_frame_pacing();
+        MINECART_PROFILE_THREAD("Main");
+        m_lastFrameTime = SDL_GetTicksNS();
+        m_accumulatedTime = 0;
 
         // Call game's init method
         if (!game->on_init()) {
@@ -118,29 +148,65 @@ namespace minecart::graphics {
             return result;
         }
 
+        // In pipelined mode the simulation ticks on its own thread from here on
+        if (game->is_pipelined()) {
+            m_simulationThread = std::make_unique<SimulationThread>();
+            m_simulationThread->start(game->get_tick_rate(), [this](double tickSeconds) {
+                return game->on_tick(tickSeconds);
+            });
+        }
+
         // Main loop
         bool running = true;
         while (running) {
+            MINECART_PROFILE_FRAME();
+
             // Start the ImGui frame BEFORE processing events
             // so we can query io.WantCaptureMouse/Keyboard
             ImGui_ImplSDLGPU3_NewFrame();
             ImGui_ImplSDL3_NewFrame();
             ImGui::NewFrame();
 
-            // Calculate delta time
-            uint64_t currentTime = SDL_GetTicks();
-            float deltaTime = (currentTime - m_lastFrameTime) / 1000.0f;
-            m_lastFrameTime = currentTime;
+            // Calculate delta time with nanosecond resolution
+            uint64_t frameStart = SDL_GetTicksNS();
+            uint64_t frameTime = frameStart - m_lastFrameTime;
+            m_lastFrameTime = frameStart;
+            m_deltaTime = static_cast<float>(frameTime * 1e-9);
 
-            game->on_update(deltaTime);
+            {
+                MINECART_PROFILE_SCOPE("Game::on_update");
+                game->on_update(m_deltaTime);
+            }
 
-            SDL_Event event;
-            while (SDL_PollEvent(&event)) {
-                result = process_event(&event);
-                if (result != SDL_APP_CONTINUE) {
-                    running = false;
+            if (m_simulationThread) {
+                if (m_simulationThread->has_quit()) {
+                    // A throwing on_tick is a crash; returning false is a normal exit
+                    result = m_simulationThread->has_failed() ? SDL_APP_FAILURE : SDL_APP_SUCCESS;
                     break;
                 }
+                m_interpolationAlpha = m_simulationThread->get_interpolation_alpha();
+            } else if (!run_fixed_updates(frameTime)) {
+                result = SDL_APP_SUCCESS;
+                break;
+            }
+
+            {
+                MINECART_PROFILE_SCOPE("Window::process_events");
+                SDL_Event event;
+                while (SDL_PollEvent(&event)) {
+                    result = process_event(&event);
+                    if (result != SDL_APP_CONTINUE) {
+                        running = false;
+                        break;
+                    }
+                }
+            }
+
+            // Continuations of worker jobs that need the main thread (GPU uploads etc.)
+            // run before rendering so their uploads are recorded this frame
+            if (running) {
+                MINECART_PROFILE_SCOPE("JobSystem::run_main_thread_jobs");
+                game->get_job_system().run_main_thread_jobs();
             }
 
             if (running) {
@@ -149,12 +215,68 @@ namespace minecart::graphics {
                     running = false;
                 }
             }
+
+            // Frame-rate cap: sleep out the rest of this frame's time slice
+            if (running && m_framePacing.maxFrameRate > 0.0) {
+                uint64_t frameEnd = frameStart + static_cast<uint64_t>(1e9 / m_framePacing.maxFrameRate);
+                uint64_t now = SDL_GetTicksNS();
+                if (now < frameEnd) {
+                    MINECART_PROFILE_SCOPE("Window::frame_cap");
+                    SDL_DelayPrecise(frameEnd - now);
+                }
+            }
         }
 
         shutdown();
         return result;
     }
 
+    bool Window::run_fixed_updates(uint64_t frameTime) {
+        float timestep = game->get_fixed_timestep();
+        if (!(timestep > 0.0f)) {
+            m_interpolationAlpha = 1.0f;
+            return true;
+        }
+
+        // Clamp long frames (loading, debugger) so the simulation does not try to
+        // replay them step by step
+        const auto step = static_cast<uint64_t>(static_cast<double>(timestep) * 1e9);
+        m_accumulatedTime += std::min(frameTime, MAX_ACCUMULATED_TIME);
+        while (m_accumulatedTime >= step) {
+            MINECART_PROFILE_SCOPE("Game::on_fixed_update");
+            if (!game->on_fixed_update(timestep)) {
+                return false;
+            }
+            m_accumulatedTime -= step;
+        }
+        m_interpolationAlpha = static_cast<float>(static_cast<double>(m_accumulatedTime) / static_cast<double>(step));
+        return true;
+    }
+
+    void Window::set_frame_pacing(const FramePacing& pacing) {
+        m_framePacing = pacing;
+        if (initialized) {
+            apply_frame_pacing();
+        }
+    }
+
+    void Window::apply_frame_pacing() {
+        SDL_GPUPresentMode mode = m_framePacing.presentMode;
+        if (!SDL_WindowSupportsGPUPresentMode(device.get(), window.get(), mode)) {
+            spdlog::warn("Present mode {} not supported, falling back to vsync", static_cast<int>(mode));
+            mode = SDL_GPU_PRESENTMODE_VSYNC;
+        }
+        if (!SDL_SetGPUSwapchainParameters(device.get(), window.get(), SDL_GPU_SWAPCHAINCOMPOSITION_SDR, mode)) {
+            throw SDLException("Failed to set swapchain parameters");
+        }
+        m_presentMode = mode;
+
+        uint32_t framesInFlight = std::clamp(m_framePacing.framesInFlight, 1u, 3u);
+        if (!SDL_SetGPUAllowedFramesInFlight(device.get(), framesInFlight)) {
+            throw SDLException("Failed to set frames in flight");
+        }
+    }
+
     SDL_AppResult Window::process_event(SDL_Event* event) {
         if (!initialized) {
             throw WindowException("Window not initialized");
@@ -185,8 +307,15 @@ namespace minecart::graphics {
             throw WindowException("Window not initialized");
         }
 
+        MINECART_PROFILE_SCOPE("Window::render_frame");
+
         // Call game's ImGui render function
-        game->on_imgui_render();
+        {
+            MINECART_PROFILE_SCOPE("Game::on_imgui_render");
+            game->on_imgui_render();
+        }
+        Profiler::get().draw_panel();
+        GpuStats::get().draw_panel();
 
         // Render ImGui
         ImGui::Render();
@@ -197,16 +326,52 @@ namespace minecart::graphics {
             throw SDLException("Failed to acquire GPU command buffer");
         }
 
+        // Let the game write per-frame data while uploads can still join this frame
+        FrameContext frameContext {
+            commandBuffer,
+            nullptr,
+            window.get(),
+            device.get(),
+            m_uploadQueue.get(),
+            &game->get_job_system(),
+            m_deltaTime,
+            m_interpolationAlpha
+        };
+        bool prepared = true;
+        try {
+            MINECART_PROFILE_SCOPE("Game::on_prepare_render");
+            game->on_prepare_render(frameContext);
+        }
+        catch (const std::exception& e) {
+            spdlog::error("Render Error: {}", e.what());
+            prepared = false; // skip on_render and exit after this frame
+        }
+
+        // Record pending buffer uploads ahead of any render pass in this frame
+        try {
+            m_stagingRing->begin_frame();
+            m_uploadQueue->record(commandBuffer);
+        }
+        catch (const UploadException& e) {
+            SDL_SubmitGPUCommandBuffer(commandBuffer);
+            throw WindowException(e.what());
+        }
+
         // Get the swapchain texture
         SDL_GPUTexture* swapchainTexture = nullptr;
         Uint32 width = 0, height = 0;
         
-        if (!SDL_WaitAndAcquireGPUSwapchainTexture(
+        bool acquired = false;
+        {
+            MINECART_PROFILE_SCOPE("Window::acquire_swapchain");
+            acquired = SDL_WaitAndAcquireGPUSwapchainTexture(
                 commandBuffer, 
                 window.get(), 
                 &swapchainTexture, 
                 &width, 
-                &height)) {
+                &height);
+        }
+        if (!acquired) {
             SDL_SubmitGPUCommandBuffer(commandBuffer);
             throw SDLException("Failed to acquire swapchain texture");
         }
@@ -214,6 +379,7 @@ namespace minecart::graphics {
         // Handle case where swapchain texture is not available (e.g., minimized window)
         if (!swapchainTexture) {
             SDL_SubmitGPUCommandBuffer(commandBuffer);
+            GpuStats::get().end_frame();
             return SDL_APP_CONTINUE;
         }
 
@@ -241,22 +407,20 @@ namespace minecart::graphics {
         }
 
         // Draw game content
-        FrameContext frameContext {
-            commandBuffer,
-            renderPass,
-            window.get(),
-            device.get()
-        };
+        frameContext.renderPass = renderPass;
 
         // Call game's render method inside try/catch so exceptions (e.g. shader
         // related errors) are logged rather than crashing the whole process.
         SDL_AppResult result = SDL_APP_SUCCESS;
-        try {
-            result = game->on_render(frameContext) ? SDL_APP_CONTINUE : SDL_APP_SUCCESS;
-        }
-        catch (const std::exception& e) {
-            spdlog::error("Render Error: {}", e.what());
-            result = SDL_APP_SUCCESS; // exit gracefully after logging
+        if (prepared) {
+            try {
+                MINECART_PROFILE_SCOPE("Game::on_render");
+                result = game->on_render(frameContext) ? SDL_APP_CONTINUE : SDL_APP_SUCCESS;
+            }
+            catch (const std::exception& e) {
+                spdlog::error("Render Error: {}", e.what());
+                result = SDL_APP_SUCCESS; // exit gracefully after logging
+            }
         }
 
         // Render ImGui draw data
@@ -266,9 +430,11 @@ namespace minecart::graphics {
         SDL_EndGPURenderPass(renderPass);
 
         // Submit the command buffer
+        MINECART_PROFILE_SCOPE("Window::submit");
         if (!SDL_SubmitGPUCommandBuffer(commandBuffer)) {
             throw SDLException("Failed to submit GPU command buffer");
         }
+        GpuStats::get().end_frame();
 
         return result;
     }
@@ -278,6 +444,12 @@ namespace minecart::graphics {
             return;
         }
 
+        // Stop simulating before the game releases what its ticks use
+        if (m_simulationThread) {
+            m_simulationThread->stop();
+            m_simulationThread.reset();
+        }
+
         // Call game's shutdown method first (while device is still valid)
         if (game) {
             game->on_shutdown();
@@ -291,6 +463,10 @@ namespace minecart::graphics {
             imguiInitialized = false;
         }
 
+        m_bufferArena.reset();
+        m_uploadQueue.reset();
+        m_stagingRing.reset();
+
         // Smart pointers will handle SDL resource cleanup automatically
         // but we reset them explicitly for clarity
         device.reset();
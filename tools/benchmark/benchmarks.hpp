@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+// Engine micro-benchmarks. Each one runs on synthetic data and logs its timings.
+
+namespace minecart::graphics {
+
+    // Cull objectCount random boxes iterations times with every supported kernel
+    void benchmark_culling(uint32_t objectCount = 10000, uint32_t iterations = 200);
+
+    // Build, refit and query random scenes of each size
+    void benchmark_scene_index(const std::vector<uint32_t>& objectCounts = {1000, 10000, 50000});
+
+} // namespace minecart::graphics
+
+namespace minecart::world {
+
+    // Mesh terrain-like and worst-case (checkerboard) sections, single-threaded and through the pool
+    void benchmark_chunk_mesher(uint32_t iterations = 200);
+
+} // namespace minecart::world
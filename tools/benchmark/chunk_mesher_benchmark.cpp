@@ -0,0 +1,122 @@
+#include "benchmarks.hpp"
+
+#include "minecart/chunk_mesher.hpp"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+
+namespace minecart::world {
+
+    void benchmark_chunk_mesher(uint32_t iterations) {
+        constexpr BlockId STONE = 1;
+        constexpr BlockId DIRT = 2;
+        constexpr BlockId GRASS = 3;
+        constexpr BlockId ORE = 4;
+        constexpr BlockId WATER = 5;
+        constexpr int CHUNKS = 4;   // CHUNKS x CHUNKS columns of one section each
+
+        std::vector<BlockVisual> visuals(6);
+        visuals[STONE].color = {128, 128, 128, 255};
+        visuals[DIRT].color = {134, 96, 67, 255};
+        visuals[GRASS].color = {95, 159, 53, 255};
+        visuals[ORE].color = {200, 180, 60, 255};
+        visuals[WATER] = BlockVisual{{40, 80, 220, 160}, false};
+
+        std::mt19937 rng(1234);
+        auto terrain = [&](int x, int y, int z) -> BlockId {
+            float height = 8.0f + 3.0f * std::sin(x * 0.3f) + 3.0f * std::cos(z * 0.25f);
+            float top = std::floor(height);
+            if (y > top) {
+                return y <= 7 ? WATER : AIR;
+            }
+            if (y == top) {
+                return GRASS;
+            }
+            if (y > top - 3) {
+                return DIRT;
+            }
+            return rng() % 16 == 0 ? ORE : STONE;
+        };
+        auto checkerboard = [](int x, int y, int z) -> BlockId {
+            return ((x + y + z) & 1) ? STONE : AIR;
+        };
+
+        struct Scene {
+            const char* name;
+            std::function<BlockId(int, int, int)> generate;
+        };
+        const std::array<Scene, 2> scenes{{{"terrain", terrain}, {"checkerboard", checkerboard}}};
+
+        const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        iterations = std::max(iterations, 1u);
+
+        ChunkMesher mesher;
+        mesher.set_block_visuals(visuals);
+
+        for (const Scene& scene : scenes) {
+            ChunkStorage storage(1);
+            for (int cx = 0; cx < CHUNKS; ++cx) {
+                for (int cz = 0; cz < CHUNKS; ++cz) {
+                    Chunk& chunk = storage.load_chunk(ChunkPos{cx, cz});
+                    for (int y = 0; y < SECTION_SIZE; ++y) {
+                        for (int z = 0; z < SECTION_SIZE; ++z) {
+                            for (int x = 0; x < SECTION_SIZE; ++x) {
+                                chunk.set_block(x, y, z, scene.generate(cx * SECTION_SIZE + x, y, cz * SECTION_SIZE + z));
+                            }
+                        }
+                    }
+                    chunk.clear_dirty();
+                }
+            }
+
+            // Single-threaded cost of one interior section
+            SectionMeshInput input;
+            ChunkMesher::gather(storage, ChunkPos{1, 1}, 0, input);
+            SectionMesh mesh;
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (uint32_t i = 0; i < iterations; ++i) {
+                ChunkMesher::mesh_section(input, visuals, mesh);
+            }
+            double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+
+            const double microsecondsPerSection = seconds * 1e6 / iterations;
+
+            // Throughput through the pool, including the gather on this thread
+            std::vector<std::unique_ptr<SectionMesh>> finished;
+            uint32_t sections = 0;
+            start = SDL_GetPerformanceCounter();
+            for (uint32_t i = 0; i < iterations; i += CHUNKS * CHUNKS) {
+                for (int cx = 0; cx < CHUNKS; ++cx) {
+                    for (int cz = 0; cz < CHUNKS; ++cz) {
+                        mesher.enqueue(storage, ChunkPos{cx, cz}, 0);
+                        sections++;
+                    }
+                }
+                mesher.collect(finished);
+                for (auto& done : finished) {
+                    mesher.recycle(std::move(done));
+                }
+                finished.clear();
+            }
+            mesher.wait();
+            seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+            mesher.collect(finished);
+            for (auto& done : finished) {
+                mesher.recycle(std::move(done));
+            }
+            finished.clear();
+            const double sectionsPerSecond = seconds > 0.0 ? sections / seconds : 0.0;
+
+            spdlog::info("Chunk mesher benchmark [{}]: {} quads, {:.1f} us/section, {:.0f} sections/sec on {} threads",
+                scene.name, mesh.quadCount, microsecondsPerSection, sectionsPerSecond, mesher.get_thread_count());
+        }
+    }
+
+} // namespace minecart::world
@@ -0,0 +1,62 @@
+#include "benchmarks.hpp"
+
+#include "minecart/culling.hpp"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <random>
+
+namespace minecart::graphics {
+
+    void benchmark_culling(uint32_t objectCount, uint32_t iterations) {
+        // Boxes scattered around the origin, viewed by a 90 degree frustum looking down -Z
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> position(-500.0f, 500.0f);
+        std::uniform_real_distribution<float> size(0.5f, 8.0f);
+
+        CullingBounds bounds;
+        bounds.reserve(objectCount);
+        for (uint32_t i = 0; i < objectCount; ++i) {
+            glm::vec3 center{position(rng), position(rng), position(rng)};
+            glm::vec3 extents{size(rng), size(rng), size(rng)};
+            bounds.add(Aabb{center - extents, center + extents});
+        }
+
+        constexpr float diagonal = 0.70710678f;
+        Frustum frustum;
+        frustum.planes[Frustum::Left] = glm::vec4{diagonal, 0.0f, -diagonal, 0.0f};
+        frustum.planes[Frustum::Right] = glm::vec4{-diagonal, 0.0f, -diagonal, 0.0f};
+        frustum.planes[Frustum::Bottom] = glm::vec4{0.0f, diagonal, -diagonal, 0.0f};
+        frustum.planes[Frustum::Top] = glm::vec4{0.0f, -diagonal, -diagonal, 0.0f};
+        frustum.planes[Frustum::Near] = glm::vec4{0.0f, 0.0f, -1.0f, -0.1f};
+        frustum.planes[Frustum::Far] = glm::vec4{0.0f, 0.0f, 1.0f, 1000.0f};
+
+        std::vector<uint32_t> visible;
+        const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+        iterations = std::max(iterations, 1u);
+
+        const CullingKernel previous = get_culling_kernel();
+        for (CullingKernel kernel : {CullingKernel::Scalar, CullingKernel::SSE2, CullingKernel::AVX2}) {
+            if (!is_culling_kernel_supported(kernel)) {
+                continue;
+            }
+            set_culling_kernel(kernel);
+
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (uint32_t i = 0; i < iterations; ++i) {
+                cull_boxes(frustum, bounds, visible);
+            }
+            double seconds = static_cast<double>(SDL_GetPerformanceCounter() - start) / frequency;
+            double secondsPerCull = seconds / iterations;
+            double objectsPerSecond = seconds > 0.0 ? static_cast<double>(objectCount) * iterations / seconds : 0.0;
+
+            spdlog::info("Culling benchmark [{}]: {} objects, {} visible, {:.1f} us/cull, {:.1f} M objects/sec",
+                get_culling_kernel_name(kernel), objectCount, visible.size(),
+                secondsPerCull * 1e6, objectsPerSecond / 1e6);
+        }
+        set_culling_kernel(previous);
+    }
+
+} // namespace minecart::graphics
@@ -0,0 +1,38 @@
+#include "benchmarks.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <string>
+
+// Runs the benchmarks named on the command line (culling, scene_index,
+// chunk_mesher), or all of them when none are given
+int main(int argc, char** argv) {
+    const bool all = argc < 2;
+    auto selected = [&](const std::string& name) {
+        for (int i = 1; i < argc; ++i) {
+            if (name == argv[i]) {
+                return true;
+            }
+        }
+        return all;
+    };
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string name = argv[i];
+        if (name != "culling" && name != "scene_index" && name != "chunk_mesher") {
+            spdlog::error("Unknown benchmark: {} (expected culling, scene_index or chunk_mesher)", name);
+            return 1;
+        }
+    }
+
+    if (selected("culling")) {
+        minecart::graphics::benchmark_culling();
+    }
+    if (selected("scene_index")) {
+        minecart::graphics::benchmark_scene_index();
+    }
+    if (selected("chunk_mesher")) {
+        minecart::world::benchmark_chunk_mesher();
+    }
+    return 0;
+}
@@ -0,0 +1,98 @@
+#include "benchmarks.hpp"
+
+#include "minecart/scene_index.hpp"
+
+#include <SDL3/SDL.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+namespace minecart::graphics {
+
+    namespace {
+
+        double elapsed_ms(Uint64 start) {
+            return static_cast<double>(SDL_GetPerformanceCounter() - start) * 1000.0
+                / static_cast<double>(SDL_GetPerformanceFrequency());
+        }
+
+    } // namespace
+
+    void benchmark_scene_index(const std::vector<uint32_t>& objectCounts) {
+        constexpr uint32_t QUERY_ITERATIONS = 100;
+        constexpr float diagonal = 0.70710678f;
+
+        // Same 90 degree frustum looking down -Z as the culling benchmark
+        Frustum frustum;
+        frustum.planes[Frustum::Left] = glm::vec4{diagonal, 0.0f, -diagonal, 0.0f};
+        frustum.planes[Frustum::Right] = glm::vec4{-diagonal, 0.0f, -diagonal, 0.0f};
+        frustum.planes[Frustum::Bottom] = glm::vec4{0.0f, diagonal, -diagonal, 0.0f};
+        frustum.planes[Frustum::Top] = glm::vec4{0.0f, -diagonal, -diagonal, 0.0f};
+        frustum.planes[Frustum::Near] = glm::vec4{0.0f, 0.0f, -1.0f, -0.1f};
+        frustum.planes[Frustum::Far] = glm::vec4{0.0f, 0.0f, 1.0f, 250.0f};
+
+        std::vector<uint32_t> hits;
+        for (uint32_t objectCount : objectCounts) {
+            // Keep density constant so query cost reflects tree quality rather than hit count
+            std::mt19937 rng(1234);
+            const float halfSize = 10.0f * std::cbrt(static_cast<float>(std::max(objectCount, 1u)));
+            std::uniform_real_distribution<float> position(-halfSize, halfSize);
+            std::uniform_real_distribution<float> size(0.5f, 2.0f);
+            std::uniform_real_distribution<float> jitter(-1.0f, 1.0f);
+            std::uniform_real_distribution<float> unit(-1.0f, 1.0f);
+
+            SceneIndex index;
+            std::vector<uint32_t> ids;
+            std::vector<Aabb> boxes;
+            ids.reserve(objectCount);
+            boxes.reserve(objectCount);
+            for (uint32_t i = 0; i < objectCount; ++i) {
+                glm::vec3 center{position(rng), position(rng), position(rng)};
+                glm::vec3 extents{size(rng), size(rng), size(rng)};
+                boxes.push_back(Aabb{center - extents, center + extents});
+                ids.push_back(index.insert(boxes.back()));
+            }
+
+            index.build();
+            const double buildMs = index.get_stats().lastBuildMs;
+
+            // Move every object a little, as a frame of simulation would
+            for (uint32_t i = 0; i < objectCount; ++i) {
+                glm::vec3 offset{jitter(rng), jitter(rng), jitter(rng)};
+                boxes[i].min += offset;
+                boxes[i].max += offset;
+                index.update(ids[i], boxes[i]);
+            }
+            index.refit();
+            const double refitMs = index.get_stats().lastRefitMs;
+
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (uint32_t i = 0; i < QUERY_ITERATIONS; ++i) {
+                index.query_frustum(frustum, hits);
+            }
+            const double frustumQueryUs = elapsed_ms(start) * 1000.0 / QUERY_ITERATIONS;
+
+            start = SDL_GetPerformanceCounter();
+            for (uint32_t i = 0; i < QUERY_ITERATIONS; ++i) {
+                glm::vec3 direction{unit(rng), unit(rng), unit(rng)};
+                (void)index.raycast(glm::vec3{0.0f}, direction, halfSize * 2.0f);
+            }
+            const double rayQueryUs = elapsed_ms(start) * 1000.0 / QUERY_ITERATIONS;
+
+            start = SDL_GetPerformanceCounter();
+            for (uint32_t i = 0; i < QUERY_ITERATIONS; ++i) {
+                glm::vec3 center{position(rng), position(rng), position(rng)};
+                index.query_radius(center, 16.0f, hits);
+            }
+            const double radiusQueryUs = elapsed_ms(start) * 1000.0 / QUERY_ITERATIONS;
+
+            SceneIndexStats stats = index.get_stats();
+            spdlog::info("Scene index benchmark: {} objects, {} nodes, depth {}, build {:.2f} ms, refit {:.2f} ms, "
+                "frustum {:.1f} us, ray {:.1f} us, radius {:.1f} us",
+                objectCount, stats.nodes, stats.depth, buildMs, refitMs, frustumQueryUs, rayQueryUs, radiusQueryUs);
+        }
+    }
+
+} // namespace minecart::graphics